@@ -1,14 +1,27 @@
 #pragma once
 #include "afv-native/atcClientWrapper.h"
 #include "afv-native/event.h"
+#include "audio/device_registry.h"
+#include "audio/radio_commands.h"
+#include "audio/radio_state.h"
+#include "audio/rx_history.h"
 #include "config.h"
 #include "data_file_handler.h"
 #include "imgui.h"
 #include "imgui_internal.h"
 #include "imgui_stdlib.h"
+#include "input/evdev_ptt.h"
+#include "input/joystick_ptt.h"
+#include "input/ptt_controller.h"
+#include "input/ptt_server.h"
 #include "ns/airport.h"
-#include "radioSimulation.h"
+#include "ns/station.h"
+#include "perf/arena.h"
+#include "perf/counters.h"
+#include "perf/instrumentation.h"
+#include "profiles.h"
 #include "sdk/sdk.h"
+#include "sdk/state_publisher.h"
 #include "shared.h"
 #include "ui/modals/settings.h"
 #include "ui/style.h"
@@ -16,11 +29,16 @@
 #include "ui/widgets/gain.widget.h"
 #include "ui/widgets/lastrx.widget.h"
 #include "ui/widgets/networkstatus.widget.h"
+#include "ui/widgets/perfoverlay.widget.h"
+#include "ui/widgets/profiles.widget.h"
+#include "ui/widgets/rxhistory.widget.h"
 #include "updater.h"
 #include "util.h"
 
 #include <SDL_audio.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <fstream>
 #include <functional>
@@ -28,7 +46,9 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <numeric>
+#include <optional>
 #include <shared_mutex>
 #include <spdlog/spdlog.h>
 #include <string>
@@ -43,6 +63,13 @@ public:
 
     void render_frame();
 
+    // Joystick device and button events, from the SDL event loop
+    void handleInputEvent(const SDL_Event& event);
+
+    // A session is up or being set up, the updater does not take the UI
+    // over then
+    [[nodiscard]] bool isConnected() const;
+
 private:
     static bool frequencyExists(int freq);
 
@@ -56,12 +83,71 @@ private:
     void eventCallback(
         afv_native::ClientEventType evt, void* data, void* data2);
 
+    // UI thread only, the afv_native callback sets pDisconnectRequested
     void disconnectAndCleanup();
+    std::atomic<bool> pDisconnectRequested = false;
+
+    // Copies a newly enumerated device list into shared, and asks for a new
+    // one when the audio API was changed in the settings
+    void syncAudioDevices();
+
+    // Restarts audio on the configured or fallback devices after a device
+    // error, without leaving the voice session, see tickAudioRecovery()
+    void tickAudioRecovery();
+
+    // Rebuilds the voice session with exponential backoff after an unexpected
+    // drop, then restores the stations as they were before it
+    void tickVoiceReconnect();
 
     static void playErrorSound();
 
     void addNewStation(std::string callsign);
 
+    // Draws one cell of the stations grid, a deletion is only recorded since
+    // the caller is iterating over the stations
+    void drawStation(
+        const ns::Station& el, std::optional<int>& deletedFrequency);
+
+    static constexpr int kStationsPerRow = 3;
+
+    // Adds the stations of a profile and queues their switches, the caller
+    // holds fetchedStationMutex
+    void restoreProfile(const profiles::Profile& profile);
+
+    // Saves the current layout under a callsign pattern
+    void saveProfile(std::string pattern);
+
+    std::vector<profiles::Profile> pProfiles;
+    std::string pActiveProfile;
+
+    // A station change for pRadioCommands, with the current effects
+    static audio::RadioCommand radioCommand(int frequencyHz,
+        std::string callsign, audio::RadioSwitches switches,
+        bool useStationTransceivers = true);
+    void submitRadioCommand(int frequencyHz, std::string callsign,
+        audio::RadioSwitches switches, bool useStationTransceivers = true);
+
+    // Adds back the stations of a captured state and queues their switches
+    // and the radio gain, the caller holds fetchedStationMutex
+    void submitRadioState(const std::vector<audio::StationState>& states);
+
+    // Control handler of the SDK, called from its request threads
+    sdk::types::ControlResult applyControl(
+        const std::vector<sdk::types::ControlOperation>& operations);
+
+    // How long an SDK control request waits for its batch to be applied
+    static constexpr auto kControlApplyTimeout
+        = std::chrono::milliseconds(2000);
+
+    // Gain set through the SDK, picked up by the next frame, -1 for none
+    std::atomic<int> pSdkRadioGain = -1;
+
+    // Backs the per frame temporaries of render_frame(), reset every frame
+    static constexpr size_t kFrameArenaSize = 8 * 1024;
+    perf::Arena<kFrameArenaSize> pFrameArena;
+
+    std::string pLicensePath;
+
     // Used in another thread
     static void loadAirportsDatabaseAsync();
 
@@ -70,8 +156,62 @@ private:
 
     std::unique_ptr<vatsim::DataHandler> pDataHandler;
 
-    bool pManuallyDisconnected = false;
+    // Read by the afv_native callback thread
+    std::atomic<bool> pManuallyDisconnected = false;
+    std::atomic<bool> pAwaitingVoiceReconnect = false;
+
+    // Declared before the SDK, which reads it from its handlers
+    audio::RxHistory pRxHistory;
+
+    // Declared before the SDK, which hands it websocket PTT commands
+    std::unique_ptr<input::PttController> pPtt;
+    std::unique_ptr<input::JoystickPtt> pJoystickPtt;
+    // Null when the keyboard is polled from render_frame()
+    std::unique_ptr<input::EvdevPtt> pEvdevPtt;
+    // Also polled with evdev when the key has no evdev code
+    bool pKeyboardPolled = true;
 
     std::unique_ptr<SDK> pSDK;
+
+    std::unique_ptr<input::PttServer> pPttServer;
+
+    // Radio state for shared memory readers, rewritten when it changes
+    std::unique_ptr<sdk::StatePublisher> pStatePublisher;
+    void publishRadioState(
+        const std::pmr::vector<std::pmr::string>& liveReceivedCallsigns);
+
+    // Reset before the SDK, its worker reports every batch to it
+    std::unique_ptr<audio::RadioCommandQueue> pRadioCommands;
+
+    std::unique_ptr<audio::DeviceRegistry> pAudioDevices;
+    uint64_t pAudioDevicesGeneration = 0;
+    bool pAudioApiResolved = false;
+    // Device lists of the selected API were copied into shared at least once
+    bool pAudioDevicesReady = false;
+    unsigned int pAudioDevicesApi = -1;
+
+    static constexpr auto kAudioRecoveryRetryInterval
+        = std::chrono::seconds(2);
+    static constexpr auto kAudioRecoveryTimeout = std::chrono::seconds(60);
+
+    // Set from the afv_native callback thread, handled on the UI thread
+    std::atomic<bool> pAudioRecoveryRequested = false;
+    std::atomic<bool> pRecoveringAudio = false;
+    std::chrono::steady_clock::time_point pAudioRecoveryStarted;
+    std::chrono::steady_clock::time_point pAudioRecoveryLastAttempt;
+    std::vector<audio::StationState> pAudioRecoveryState;
+
+    static constexpr auto kVoiceReconnectBaseDelay
+        = std::chrono::milliseconds(1000);
+    static constexpr auto kVoiceReconnectMaxDelay = std::chrono::seconds(30);
+    static constexpr int kVoiceReconnectMaxAttempts = 8;
+
+    // Set from the afv_native callback thread, handled on the UI thread
+    std::atomic<bool> pVoiceReconnectRequested = false;
+    std::atomic<bool> pReconnectingVoice = false;
+    // UI thread only
+    int pVoiceReconnectAttempts = 0;
+    std::chrono::steady_clock::time_point pVoiceReconnectNextAttempt;
+    std::vector<audio::StationState> pVoiceReconnectState;
 };
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include "afv-native/atcClientWrapper.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <SDL_events.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vector_audio::audio {
+
+struct DeviceSnapshot {
+    uint64_t generation = 0;
+    unsigned int audioApi = -1;
+    std::map<unsigned int, std::string> audioApis;
+    std::vector<std::string> inputDevices;
+    std::vector<std::string> outputDevices;
+};
+
+/*
+ * Enumerates the audio APIs and devices on a background thread, as some
+ * backends take hundreds of milliseconds to answer. A new enumeration is
+ * started on request and on every SDL audio hotplug event, requests that
+ * arrive while one is running are coalesced into a single follow up.
+ */
+class DeviceRegistry {
+public:
+    DeviceRegistry(std::shared_ptr<afv_native::api::atcClient> client,
+        unsigned int audioApi);
+    ~DeviceRegistry();
+
+    DeviceRegistry(const DeviceRegistry&) = delete;
+    DeviceRegistry& operator=(const DeviceRegistry&) = delete;
+    DeviceRegistry(DeviceRegistry&&) = delete;
+    DeviceRegistry& operator=(DeviceRegistry&&) = delete;
+
+    // Never blocks, the result shows up in a later snapshot
+    void refresh(unsigned int audioApi);
+    void refresh();
+
+    // Latest completed enumeration, nullptr until the first one is done
+    [[nodiscard]] std::shared_ptr<const DeviceSnapshot> snapshot() const;
+
+private:
+    // A failed enumeration is retried with backoff, hotplug events and
+    // requests still retry it sooner
+    static constexpr auto kRetryBaseDelay = std::chrono::seconds(1);
+    static constexpr auto kRetryMaxDelay = std::chrono::seconds(30);
+
+    std::shared_ptr<afv_native::api::atcClient> pClient;
+
+    mutable std::mutex pMutex;
+    std::condition_variable pCv;
+    bool pRunning = true;
+    bool pRefreshPending = true;
+    unsigned int pAudioApi;
+    uint64_t pGeneration = 0;
+    std::shared_ptr<const DeviceSnapshot> pSnapshot;
+
+    std::thread pWorker;
+
+    void worker();
+
+    static int onSdlEvent(void* userdata, SDL_Event* event);
+};
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "afv-native/atcClientWrapper.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace vector_audio::audio {
+
+// Wanted radio switches of a frequency, unset ones are left as they are
+struct RadioSwitches {
+    std::optional<bool> rx;
+    std::optional<bool> tx;
+    std::optional<bool> xc;
+    std::optional<bool> onHeadset;
+
+    // Fields set in newer win
+    void merge(const RadioSwitches& newer);
+};
+
+struct RadioCommand {
+    int frequencyHz = 0;
+    // Added under this callsign when the frequency is not active yet
+    std::string callsign;
+    // Manual and UNICOM frequencies have no station transceivers
+    bool useStationTransceivers = true;
+    // Applied once a batch added a frequency
+    bool inputFilter = true;
+    bool outputEffects = true;
+    // Drops the frequency, anything queued for it before is discarded
+    bool remove = false;
+    // Drops the frequency before applying the switches, set when a command
+    // follows a queued removal so nothing of the old state survives
+    bool resetFirst = false;
+    RadioSwitches switches;
+};
+
+/*
+ * Applies radio changes to afv_native on a worker thread, so that toggling
+ * stations never blocks the UI on the client.
+ *
+ * Commands are coalesced per frequency until the worker picks them up, the
+ * latest wanted state wins. A batch only calls the client for what differs
+ * from its current state, and sets the effects and the radio gain once for
+ * the whole batch instead of once per station.
+ */
+class RadioCommandQueue {
+public:
+    // Called on the worker after each batch
+    using AppliedHandler = std::function<void()>;
+
+    RadioCommandQueue(std::shared_ptr<afv_native::api::atcClient> client,
+        float radioGain, AppliedHandler onApplied);
+    ~RadioCommandQueue();
+
+    RadioCommandQueue(const RadioCommandQueue&) = delete;
+    RadioCommandQueue& operator=(const RadioCommandQueue&) = delete;
+    RadioCommandQueue(RadioCommandQueue&&) = delete;
+    RadioCommandQueue& operator=(RadioCommandQueue&&) = delete;
+
+    // Each submission returns a version, see waitApplied()
+    uint64_t submit(RadioCommand command);
+
+    // The commands are guaranteed to end up in the same batch
+    uint64_t submit(std::vector<RadioCommand> commands);
+
+    // Applied to every frequency, repeated changes are coalesced
+    uint64_t setRadioGain(float gain);
+
+    // Waits until everything up to the version was applied, false on timeout
+    bool waitApplied(uint64_t version, std::chrono::milliseconds timeout);
+
+    // Switches queued or being applied for the frequency, for the UI to show
+    // a click before the client has seen it
+    [[nodiscard]] std::optional<RadioSwitches> pending(int frequencyHz) const;
+
+    // Drops everything not applied yet and waits for the running batch
+    void clear();
+
+private:
+    // Gives rapid clicks on several stations a chance to land in one batch
+    static constexpr auto kBatchWindow = std::chrono::milliseconds(15);
+
+    std::shared_ptr<afv_native::api::atcClient> pClient;
+    AppliedHandler pOnApplied;
+
+    mutable std::mutex pMutex;
+    std::condition_variable pCv;
+    std::condition_variable pIdleCv;
+    bool pRunning = true;
+    bool pApplying = false;
+    std::map<int, RadioCommand> pQueued;
+    std::map<int, RadioCommand> pApplyingCommands;
+    float pRadioGain;
+    bool pRadioGainChanged = false;
+    uint64_t pSubmittedVersion = 0;
+    uint64_t pAppliedVersion = 0;
+
+    std::thread pWorker;
+
+    // Merges into pQueued, pMutex must be held
+    void queue(RadioCommand command);
+
+    void worker();
+
+    void apply(const std::map<int, RadioCommand>& batch, float radioGain,
+        bool radioGainChanged);
+};
+}
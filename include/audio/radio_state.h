@@ -0,0 +1,23 @@
+#pragma once
+#include "afv-native/atcClientWrapper.h"
+#include "ns/station.h"
+
+#include <string>
+#include <vector>
+
+namespace vector_audio::audio {
+
+// Per station radio state as known by afv_native
+struct StationState {
+    std::string callsign;
+    int frequencyHz = 0;
+    bool rx = false;
+    bool tx = false;
+    bool xc = false;
+    bool onHeadset = true;
+};
+
+// Reads the state of every station that currently has an active frequency
+std::vector<StationState> captureRadioState(
+    afv_native::api::atcClient& client, const std::vector<ns::Station>& stations);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace vector_audio::audio {
+
+/*
+ * Fixed capacity history of received transmissions, fed from the StationRxBegin
+ * and StationRxEnd events.
+ *
+ * There is a single writer, the afv_native callback thread, which never blocks
+ * nor allocates. Each slot is a seqlock: the writer makes its version odd while
+ * it updates the slot, and readers retry a copy that raced with a write. Once
+ * the ring is full the oldest entries are overwritten.
+ */
+class RxHistory {
+public:
+    static constexpr size_t kCapacity = 256;
+    static constexpr size_t kCallsignSize = 16;
+
+    struct Entry {
+        uint64_t id = 0; // Starts at 1, increases by one per transmission
+        std::array<char, kCallsignSize> callsign {}; // Null terminated
+        int frequencyHz = 0;
+        int64_t startMs = 0; // Unix time
+        int64_t durationMs = -1; // -1 while still being received
+
+        [[nodiscard]] bool isOpen() const { return durationMs < 0; }
+    };
+
+    // Writer side, afv_native callback thread only
+    void begin(std::string_view callsign, int frequencyHz,
+        std::chrono::system_clock::time_point at);
+    void end(std::string_view callsign, int frequencyHz,
+        std::chrono::system_clock::time_point at);
+
+    // Id of the latest entry, 0 when empty
+    [[nodiscard]] uint64_t latestId() const;
+
+    // Appends the entries newer than sinceId, oldest first. Entries that were
+    // overwritten in the meantime are skipped. Safe from any thread.
+    void copySince(uint64_t sinceId, std::vector<Entry>& out) const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> version { 0 };
+        std::atomic<uint64_t> id { 0 };
+        std::array<std::atomic<uint64_t>, kCallsignSize / sizeof(uint64_t)>
+            callsign {};
+        std::atomic<int> frequencyHz { 0 };
+        std::atomic<int64_t> startMs { 0 };
+        std::atomic<int64_t> durationMs { -1 };
+    };
+
+    static constexpr int kReadAttempts = 4;
+
+    bool readSlot(const Slot& slot, uint64_t id, Entry& out) const;
+
+    std::array<Slot, kCapacity> pSlots;
+
+    // Id of the latest begin(), published once its slot is written
+    std::atomic<uint64_t> pLatestId { 0 };
+};
+}
@@ -0,0 +1,294 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace vector_audio::channels {
+
+/*
+ * Compile time table of every VHF airband channel name from 118.000 to
+ * 136.990 MHz, with its carrier frequency.
+ *
+ * Frequencies are handled as channel names in Hz, as on VATSIM. Each 25 kHz
+ * block starting at x.x00 holds the 25 kHz channel x.x00 and the 8.33 kHz
+ * channels x.x05, x.x10 and x.x15, on carriers x.x00, x.x0833 and x.x1667.
+ * The x.x20 names do not exist. 132.830 is the 8.33 kHz channel on 132.825.
+ *
+ * Rounding follows the rules of swift pilotclient's CComSystem, which
+ * RadioSimulation used to implement with modulo arithmetic.
+ */
+
+constexpr int kBandStartKHz = 118000;
+constexpr int kBandEndKHz = 136990; // Last channel name
+constexpr int kNameStepKHz = 5;
+constexpr int kBlockKHz = 25;
+constexpr int kChannelsPerBlock = 4;
+
+constexpr size_t kBlockCount = (kBandEndKHz - kBandStartKHz) / kBlockKHz + 1;
+constexpr size_t kChannelCount = kBlockCount * kChannelsPerBlock;
+
+// 5 kHz name steps across the band, the invalid x.x20 ones included
+constexpr size_t kStepCount = (kBandEndKHz - kBandStartKHz) / kNameStepKHz + 1;
+
+constexpr int kStepsPerBlock = kBlockKHz / kNameStepKHz;
+
+// kHz values rounded through kRoundDelta, up to 136.999
+constexpr int kRoundedSpanKHz = static_cast<int>(kBlockCount) * kBlockKHz;
+
+// "132.830" and its null terminator
+constexpr size_t kNameLength = 7;
+using NameText = std::array<char, kNameLength + 1>;
+
+struct Channel {
+    int nameKHz = 0;
+    int carrierHz = 0; // 8.33 kHz carriers are rounded to the Hz
+    bool is8_33kHz = false;
+    NameText name {};
+};
+
+namespace detail {
+    // Six digit kHz values only
+    constexpr NameText formatKHz(int kHz)
+    {
+        NameText text {};
+        for (int i = static_cast<int>(kNameLength) - 1; i >= 0; i--) {
+            if (i == 3) {
+                text[i] = '.';
+                continue;
+            }
+            text[i] = static_cast<char>('0' + kHz % 10);
+            kHz /= 10;
+        }
+        return text;
+    }
+
+    constexpr std::array<Channel, kChannelCount> buildChannels()
+    {
+        // Carrier offset of each name in its block, in Hz
+        constexpr std::array<int, kChannelsPerBlock> kCarrierOffsetHz
+            = { 0, 0, 8333, 16667 };
+
+        std::array<Channel, kChannelCount> channels {};
+        for (size_t block = 0; block < kBlockCount; block++) {
+            int blockKHz = kBandStartKHz + static_cast<int>(block) * kBlockKHz;
+            for (size_t slot = 0; slot < kChannelsPerBlock; slot++) {
+                Channel& channel = channels[block * kChannelsPerBlock + slot];
+                channel.nameKHz
+                    = blockKHz + static_cast<int>(slot) * kNameStepKHz;
+                channel.carrierHz
+                    = blockKHz * 1000 + kCarrierOffsetHz[slot];
+                channel.is8_33kHz = slot != 0;
+                channel.name = formatKHz(channel.nameKHz);
+            }
+        }
+        return channels;
+    }
+
+    // Index in kChannels of every name step, -1 for the x.x20 ones
+    constexpr std::array<int16_t, kStepCount> buildStepIndex()
+    {
+        std::array<int16_t, kStepCount> index {};
+        for (size_t step = 0; step < kStepCount; step++) {
+            int block = static_cast<int>(step) / kStepsPerBlock;
+            int slot = static_cast<int>(step) % kStepsPerBlock;
+            index[step] = slot < kChannelsPerBlock
+                ? static_cast<int16_t>(block * kChannelsPerBlock + slot)
+                : int16_t { -1 };
+        }
+        return index;
+    }
+
+    // Whether a step, relative to the start of a block, is a channel name
+    constexpr bool isNameStep(int stepInBlock)
+    {
+        return (stepInBlock % kStepsPerBlock + kStepsPerBlock) % kStepsPerBlock
+            < kChannelsPerBlock;
+    }
+
+    using RoundDelta
+        = std::array<std::array<int8_t, kNameStepKHz>, kStepsPerBlock>;
+
+    // Name steps to add to round a kHz value, by the position of its step in
+    // the block and the kHz left over. The nearest valid name on either side
+    // is at most two steps away, and ties go up.
+    constexpr RoundDelta buildRoundDelta()
+    {
+        RoundDelta delta {};
+        for (int slot = 0; slot < kStepsPerBlock; slot++) {
+            for (int remainder = 0; remainder < kNameStepKHz; remainder++) {
+                if (remainder == 0 && isNameStep(slot)) {
+                    continue;
+                }
+
+                int lower = isNameStep(slot) ? slot : slot - 1;
+                int upper = isNameStep(slot + 1) ? slot + 1 : slot + 2;
+                int toLower = remainder + (slot - lower) * kNameStepKHz;
+                int toUpper = (upper - slot) * kNameStepKHz - remainder;
+                delta[slot][remainder] = static_cast<int8_t>(
+                    (toLower < toUpper ? lower : upper) - slot);
+            }
+        }
+        return delta;
+    }
+}
+
+inline constexpr std::array<Channel, kChannelCount> kChannels
+    = detail::buildChannels();
+inline constexpr std::array<int16_t, kStepCount> kStepIndex
+    = detail::buildStepIndex();
+inline constexpr detail::RoundDelta kRoundDelta = detail::buildRoundDelta();
+
+// Table entry of a channel name, nullptr when it is not a channel
+constexpr const Channel* find(int frequencyHz)
+{
+    if (frequencyHz % 1000 != 0) {
+        return nullptr;
+    }
+
+    int kHz = frequencyHz / 1000;
+    if (kHz < kBandStartKHz || kHz > kBandEndKHz
+        || (kHz - kBandStartKHz) % kNameStepKHz != 0) {
+        return nullptr;
+    }
+
+    auto index = kStepIndex[(kHz - kBandStartKHz) / kNameStepKHz];
+    return index < 0 ? nullptr : &kChannels[index];
+}
+
+// Outside of the band the same digit rules apply, so special frequencies
+// such as 199.998 for observers are kept as they are
+constexpr bool isValidKHz(int kHz)
+{
+    if (kHz >= kBandStartKHz && kHz <= kBandEndKHz) {
+        return find(kHz * 1000) != nullptr;
+    }
+
+    const int lastDigits = kHz % 100;
+    return kHz % kNameStepKHz == 0 && lastDigits != 20 && lastDigits != 45
+        && lastDigits != 70 && lastDigits != 95;
+}
+
+// Nearest channel name, ties go up. Anything below the kHz is dropped first.
+constexpr int roundHz(int frequencyHz)
+{
+    int kHz = frequencyHz / 1000;
+    if (kHz < kBandStartKHz || kHz >= kBandStartKHz + kRoundedSpanKHz) {
+        if (isValidKHz(kHz)) {
+            return kHz * 1000;
+        }
+        return (kHz < kBandStartKHz ? kBandStartKHz : kBandEndKHz) * 1000;
+    }
+
+    int step = (kHz - kBandStartKHz) / kNameStepKHz;
+    int remainder = (kHz - kBandStartKHz) % kNameStepKHz;
+    int rounded = kBandStartKHz
+        + (step + kRoundDelta[step % kStepsPerBlock][remainder])
+            * kNameStepKHz;
+    return std::min(rounded, kBandEndKHz) * 1000;
+}
+
+// Carrier frequency of a channel name
+constexpr std::optional<int> carrierHz(int frequencyHz)
+{
+    const Channel* channel = find(frequencyHz);
+    if (channel == nullptr) {
+        return std::nullopt;
+    }
+    return channel->carrierHz;
+}
+
+// Channel name of the nearest carrier. A carrier on the 25 kHz grid is both
+// x.x00 and the 8.33 kHz x.x05, prefer8_33kHz picks the latter.
+constexpr std::optional<int> nameFromCarrierHz(
+    int carrierHz, bool prefer8_33kHz = false)
+{
+    constexpr int kBlockHz = kBlockKHz * 1000;
+    if (carrierHz < kBandStartKHz * 1000
+        || carrierHz >= kBandStartKHz * 1000
+                + static_cast<int>(kBlockCount) * kBlockHz) {
+        return std::nullopt;
+    }
+
+    int offset = carrierHz - kBandStartKHz * 1000;
+    int block = offset / kBlockHz;
+    // Nearest third of the block, 3 being the start of the next one
+    int third = ((offset % kBlockHz) * 3 + kBlockHz / 2) / kBlockHz;
+    if (third == 3) {
+        block++;
+        third = 0;
+    }
+
+    int slot = third == 0 ? (prefer8_33kHz ? 1 : 0) : third + 1;
+    size_t index = static_cast<size_t>(block) * kChannelsPerBlock + slot;
+    if (index >= kChannelCount) {
+        return std::nullopt;
+    }
+    return kChannels[index].nameKHz * 1000;
+}
+
+// "132.830" for 132830000, from the table when it is a channel
+inline std::string formatName(int frequencyHz)
+{
+    if (const Channel* channel = find(frequencyHz)) {
+        return { channel->name.data(), kNameLength };
+    }
+
+    int kHz = frequencyHz / 1000;
+    if (kHz >= 100000 && kHz <= 999999) {
+        return { detail::formatKHz(kHz).data(), kNameLength };
+    }
+
+    std::string text = std::to_string(kHz);
+    if (text.size() > 3) {
+        text.insert(3, 1, '.');
+    }
+    return text;
+}
+
+/*
+ * Channel name text to Hz, without validating the channel. Accepts
+ * "132.830", "132.83" and the six digit "132830". nullopt on anything else.
+ */
+constexpr std::optional<int> parseName(std::string_view text)
+{
+    auto dot = text.find('.');
+    std::string_view mhz = text.substr(0, dot);
+    std::string_view decimals = dot == std::string_view::npos
+        ? std::string_view {}
+        : text.substr(dot + 1);
+
+    auto parseDigits = [](std::string_view digits, int& value) {
+        value = 0;
+        for (char c : digits) {
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    };
+
+    int kHz = 0;
+    if (dot == std::string_view::npos) {
+        if (text.size() != 6 || !parseDigits(text, kHz)) {
+            return std::nullopt;
+        }
+        return kHz * 1000;
+    }
+
+    int whole = 0;
+    int fraction = 0;
+    if (mhz.empty() || mhz.size() > 3 || decimals.size() > 3
+        || !parseDigits(mhz, whole) || !parseDigits(decimals, fraction)) {
+        return std::nullopt;
+    }
+    for (size_t i = decimals.size(); i < 3; i++) {
+        fraction *= 10;
+    }
+    return (whole * 1000 + fraction) * 1000;
+}
+}
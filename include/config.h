@@ -6,9 +6,13 @@
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/spdlog.h"
 
+#include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <SFML/Config.hpp>
 #include <string>
 #include <thread>
@@ -34,7 +38,30 @@ public:
 
     static void build_logger();
 
+    // Snapshots mConfig and hands it to the writer thread, which saves it
+    // once changes have settled. mConfig must only be mutated from the UI
+    // thread, which is also the only caller of this function.
     static void write_config_async();
+
+    // Stops the writer thread, saving any pending change first
+    static void flush_config();
+
+private:
+    // Quiet period before a burst of changes is written
+    static constexpr std::chrono::milliseconds kWriteDebounce { 500 };
+    // Upper bound on how long a change can stay unsaved during a burst
+    static constexpr std::chrono::milliseconds kWriteMaxDelay { 3000 };
+
+    inline static std::condition_variable mConfigWriterCv;
+    inline static std::unique_ptr<std::thread> mConfigWriterThread;
+    inline static bool mConfigWriterRunning = false;
+    inline static std::optional<toml::value> mPendingConfig;
+    inline static std::chrono::steady_clock::time_point mFirstPendingChange;
+    inline static std::chrono::steady_clock::time_point mLastPendingChange;
+
+    static void config_writer_worker();
+
+    static void write_config_file(const toml::value& config);
 };
 
 }
\ No newline at end of file
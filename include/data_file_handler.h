@@ -1,5 +1,9 @@
 #pragma once
+#include "perf/counters.h"
+#include "perf/instrumentation.h"
+#include "poll_scheduler.h"
 #include "shared.h"
+#include "slurper_parser.h"
 #include "util.h"
 
 #include <absl/strings/match.h>
@@ -11,12 +15,14 @@
 #include <httplib.h>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <nlohmann/json.hpp>
 #include <nlohmann/json_fwd.hpp>
 #include <random>
 #include <regex>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -50,22 +56,45 @@ public:
     bool getPilotPositionWithAnything(
         const std::string& callsign, double& latitude, double& longitude);
 
+    // Wakes the worker for a poll now, then keeps polling fast for a while
+    void requestPoll();
+
+    // Session state pushed by a local plugin. It is applied immediately and
+    // polling results that contradict it are ignored for kPushGracePeriod,
+    // as the VATSIM endpoints lag behind the network.
+    void pushSessionConnected(const std::string& callsign, int frequencyHz,
+        int facility, double latitude, double longitude);
+    void pushSessionDisconnected();
+
 private:
     std::regex pRegexp;
     std::unique_ptr<std::thread> pWorkerThread;
     std::atomic<bool> pKeepRunning = true;
     std::condition_variable pCv;
     std::mutex pDfMutex;
+    bool pPollRequested = false;
+
+    // Only used by the worker thread
+    PollScheduler pScheduler;
+    // Whether the last connection status check could not reach its endpoint
+    std::atomic<bool> pLastPollFailed = false;
 
     std::string pDatafileHost;
     std::string pDatafileUrl;
 
     bool pSlurperAvailable = false;
     bool pDataFileAvailable = false;
-    bool pHadOneDisconnect = false;
+    std::atomic<bool> pHadOneDisconnect = false;
+
+    // Guarded by shared::session::m
+    static constexpr auto kPushGracePeriod = 60s;
+    std::optional<std::chrono::steady_clock::time_point> pLastPushAt;
+    bool pPushedConnected = false;
     bool pYx = false;
 
-    static std::string downloadString(httplib::Client& cli, std::string url);
+    // Returns an empty string on error, failed is set when given
+    static std::string downloadString(
+        httplib::Client& cli, std::string url, bool* failed = nullptr);
 
     bool parseSlurper(const std::string& sluper_data);
 
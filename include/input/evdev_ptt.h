@@ -0,0 +1,71 @@
+#pragma once
+#include "input/ptt_controller.h"
+
+#include <SFML/Window/Keyboard.hpp>
+#include <atomic>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace vector_audio::input {
+
+/*
+ * Keyboard PTT read straight from the evdev devices on Linux, on its own
+ * thread. It works whatever the window focus or display server, Wayland
+ * included, and hands edges to the PttController with their kernel
+ * timestamp instead of waiting for a frame to poll the key.
+ *
+ * Reading /dev/input/event* usually needs the input group, start() fails
+ * when no keyboard can be opened and the keyboard is polled as before.
+ */
+class EvdevPtt {
+public:
+    explicit EvdevPtt(PttController& ptt);
+    ~EvdevPtt();
+
+    EvdevPtt(const EvdevPtt&) = delete;
+    EvdevPtt& operator=(const EvdevPtt&) = delete;
+    EvdevPtt(EvdevPtt&&) = delete;
+    EvdevPtt& operator=(EvdevPtt&&) = delete;
+
+    // False if no keyboard could be opened, or on other platforms
+    bool start();
+
+    static bool isSupported();
+
+    // The PTT key, cheap when it did not change so it can be set every frame.
+    // False when the key has no evdev code, the caller has to poll it
+    bool setKey(sf::Keyboard::Scancode key);
+
+private:
+    PttController& pPtt;
+
+    // UI thread only
+    sf::Keyboard::Scancode pScancode = sf::Keyboard::Scan::Unknown;
+    bool pKeyReadable = true;
+
+    std::atomic<int> pKey = 0;
+    std::atomic<bool> pStopping = false;
+    int pWakeFd = -1;
+    int pInotifyFd = -1;
+    std::thread pThread;
+
+    // Reader thread only once started
+    struct Device {
+        std::string path;
+        bool monotonic = false; // timestamps on the steady clock
+    };
+    std::map<int, Device> pDevices;
+    std::set<int> pPressed;
+    int pActiveKey = 0;
+
+    void run();
+    bool openDevice(const std::string& path);
+    void closeDevice(int fd);
+    void readDevice(int fd);
+    void readInotify();
+    void applyKey();
+    void setPressed(int fd, bool pressed, perf::Clock::time_point at);
+};
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+
+namespace vector_audio::input {
+
+/*
+ * A joystick button driving PTT. The device is matched by its GUID, which
+ * unlike the SDL instance id survives unplugging and restarts, an empty GUID
+ * matches any device. With a frequency, the button transmits on that
+ * frequency only while it is held.
+ */
+struct JoystickBinding {
+    std::string guid;
+    std::string deviceName;
+    int button = -1;
+    int frequencyHz = 0; // 0 for the general PTT
+};
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "input/joystick_binding.h"
+#include "input/ptt_controller.h"
+
+#include <SDL_events.h>
+#include <SDL_joystick.h>
+#include <map>
+#include <string>
+#include <toml.hpp>
+#include <utility>
+#include <vector>
+
+namespace vector_audio::input {
+
+// [[joystick_ptt]] entries of config.toml. Without any, the single
+// joyStickPtt button of older versions is taken as an any-device binding.
+std::vector<JoystickBinding> loadJoystickBindings(const toml::value& config);
+
+// Replaces the [[joystick_ptt]] array of the config
+void storeJoystickBindings(
+    toml::value& config, const std::vector<JoystickBinding>& bindings);
+
+/*
+ * Joystick PTT from SDL events, the button edges are handed to the
+ * PttController as they are pumped, with no per frame device lookup. Every
+ * joystick is opened as it is enumerated and closed when it goes away,
+ * releasing whatever it held. The bindings are read from
+ * shared::joystickBindings on every press.
+ *
+ * Only used from the thread pumping SDL events.
+ */
+class JoystickPtt {
+public:
+    explicit JoystickPtt(PttController& ptt);
+    ~JoystickPtt();
+
+    JoystickPtt(const JoystickPtt&) = delete;
+    JoystickPtt& operator=(const JoystickPtt&) = delete;
+    JoystickPtt(JoystickPtt&&) = delete;
+    JoystickPtt& operator=(JoystickPtt&&) = delete;
+
+    // Device and button events, anything else is ignored
+    void handleEvent(const SDL_Event& event);
+
+    // The binding for a button of an open joystick
+    static JoystickBinding describe(
+        SDL_JoystickID instanceId, int button, int frequencyHz);
+
+private:
+    PttController& pPtt;
+
+    std::map<SDL_JoystickID, SDL_Joystick*> pDevices;
+
+    // Frequencies of the bindings a held button matched, 0 for the general
+    // PTT, so that a release undoes exactly what the press did
+    std::map<std::pair<SDL_JoystickID, int>, std::vector<int>> pHeld;
+    int pGeneralHeld = 0;
+
+    void open(int deviceIndex);
+    void close(SDL_JoystickID instanceId);
+    void press(SDL_JoystickID instanceId, int button);
+    void release(SDL_JoystickID instanceId, int button);
+};
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "afv-native/atcClientWrapper.h"
+#include "input/ptt_protocol.h"
+#include "perf/instrumentation.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace vector_audio::input {
+
+/*
+ * Owns the PTT of the client. The local keyboard and joysticks, any number
+ * of external senders and the frequency keys each hold their own state, and
+ * PTT is open while any of them is pressed. SetPtt is only called on edges,
+ * on the thread that caused them, so external senders never wait for a
+ * frame.
+ *
+ * Every external sender has its own sequence, a command that is not newer
+ * than the last one seen from the same sender is dropped. A sender that
+ * stays quiet for kSenderTimeout is forgotten, which releases it if it was
+ * pressed and lets it start its sequence again.
+ */
+class PttController {
+public:
+    // Called after a TX command changed a frequency, on the input thread
+    using TxChangedHandler = std::function<void()>;
+
+    PttController(std::shared_ptr<afv_native::api::atcClient> client,
+        TxChangedHandler onTxChanged);
+
+    PttController(const PttController&) = delete;
+    PttController& operator=(const PttController&) = delete;
+    PttController(PttController&&) = delete;
+    PttController& operator=(PttController&&) = delete;
+
+    enum class LocalSource : uint8_t {
+        kKeyboard = 1U << 0U,
+        kJoystick = 1U << 1U,
+    };
+
+    void setLocal(
+        LocalSource source, bool pressed, perf::Clock::time_point observedAt);
+
+    // Forgets the senders quiet for kSenderTimeout, called every frame
+    void expire(perf::Clock::time_point now);
+
+    /**
+     * A key transmitting on one frequency only, for controllers. While any
+     * frequency key is held TX is narrowed to the keyed frequencies, the TX
+     * switches are put back once the last one is released.
+     */
+    void setFrequencyKey(
+        int frequencyHz, bool pressed, perf::Clock::time_point observedAt);
+
+    // False when the command was stale or not allowed
+    bool handle(uint64_t sender, const PttCommand& command,
+        perf::Clock::time_point receivedAt);
+
+    // Forgets a sender that went away, releasing it if it was pressed
+    void release(uint64_t sender);
+
+    // Drops every sender and closes PTT, on disconnect
+    void reset();
+
+    [[nodiscard]] bool isOpen() const;
+
+private:
+    static constexpr auto kSenderTimeout = std::chrono::seconds(3);
+
+    struct Sender {
+        uint32_t sequence = 0;
+        bool pressed = false;
+        perf::Clock::time_point lastSeen;
+    };
+
+    std::shared_ptr<afv_native::api::atcClient> pClient;
+    TxChangedHandler pOnTxChanged;
+
+    std::mutex pMutex;
+    uint8_t pLocalSources = 0;
+    std::map<uint64_t, Sender> pSenders;
+    std::atomic<bool> pOpen = false;
+
+    // Frequency keys held, with how many of them, and the TX switches they
+    // overrode
+    std::map<unsigned int, int> pKeyedFrequencies;
+    std::map<unsigned int, bool> pSavedTx;
+
+    // Applies the combined state, pMutex must be held
+    void update(perf::Metric metric, perf::Clock::time_point observedAt);
+
+    // TX on the keyed frequencies only, or back to pSavedTx when none is.
+    // True if a switch changed, pMutex must be held
+    bool applyKeyedTx();
+};
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace vector_audio::input {
+
+/*
+ * PTT datagram sent by hardware panels and plugins to the loopback UDP port,
+ * 16 bytes, little endian:
+ *
+ *   0  char[4]  magic "VAPT"
+ *   4  uint32   sequence, increasing per sender, stale ones are dropped
+ *   8  uint8    command, 0 PTT, 1 TX on a frequency
+ *   9  uint8    1 pressed or TX on, 0 released or TX off
+ *  10  uint16   reserved, 0
+ *  12  uint32   frequency in Hz, TX only
+ *
+ * A sender holding PTT must repeat its state at least every second, see
+ * PttController.
+ */
+constexpr size_t kPttPacketSize = 16;
+constexpr std::array<uint8_t, 4> kPttMagic = { 'V', 'A', 'P', 'T' };
+
+struct PttCommand {
+    enum class Kind : uint8_t { kPtt = 0, kTx = 1 };
+
+    Kind kind = Kind::kPtt;
+    bool on = false;
+    uint32_t sequence = 0;
+    int frequencyHz = 0;
+};
+
+namespace detail {
+    constexpr uint32_t readU32(const uint8_t* p)
+    {
+        return static_cast<uint32_t>(p[0])
+            | static_cast<uint32_t>(p[1]) << 8U
+            | static_cast<uint32_t>(p[2]) << 16U
+            | static_cast<uint32_t>(p[3]) << 24U;
+    }
+
+    constexpr void writeU32(uint8_t* p, uint32_t v)
+    {
+        for (size_t i = 0; i < 4; i++) {
+            p[i] = static_cast<uint8_t>(v >> (8U * i));
+        }
+    }
+}
+
+constexpr std::optional<PttCommand> decodePttPacket(
+    const uint8_t* data, size_t size)
+{
+    if (size != kPttPacketSize) {
+        return std::nullopt;
+    }
+    for (size_t i = 0; i < kPttMagic.size(); i++) {
+        if (data[i] != kPttMagic[i]) {
+            return std::nullopt;
+        }
+    }
+    if (data[8] > static_cast<uint8_t>(PttCommand::Kind::kTx)
+        || data[9] > 1) {
+        return std::nullopt;
+    }
+
+    PttCommand command;
+    command.sequence = detail::readU32(data + 4);
+    command.kind = static_cast<PttCommand::Kind>(data[8]);
+    command.on = data[9] == 1;
+    command.frequencyHz = static_cast<int>(detail::readU32(data + 12));
+    return command;
+}
+
+constexpr std::array<uint8_t, kPttPacketSize> encodePttPacket(
+    const PttCommand& command)
+{
+    std::array<uint8_t, kPttPacketSize> packet {};
+    for (size_t i = 0; i < kPttMagic.size(); i++) {
+        packet[i] = kPttMagic[i];
+    }
+    detail::writeU32(packet.data() + 4, command.sequence);
+    packet[8] = static_cast<uint8_t>(command.kind);
+    packet[9] = command.on ? 1 : 0;
+    detail::writeU32(
+        packet.data() + 12, static_cast<uint32_t>(command.frequencyHz));
+    return packet;
+}
+}
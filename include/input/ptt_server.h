@@ -0,0 +1,49 @@
+#pragma once
+#include "input/ptt_protocol.h"
+#include "perf/instrumentation.h"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <restinio/asio_include.hpp>
+#include <thread>
+
+namespace vector_audio::input {
+
+/*
+ * Receives PTT datagrams on a loopback UDP port, on its own thread. Commands
+ * are handed over with the time they were received at, straight from the
+ * socket callback.
+ */
+class PttServer {
+public:
+    // The sender is the source address and port of the datagram
+    using Handler = std::function<void(
+        uint64_t sender, const PttCommand&, perf::Clock::time_point)>;
+
+    PttServer(uint16_t port, Handler handler);
+    ~PttServer();
+
+    PttServer(const PttServer&) = delete;
+    PttServer& operator=(const PttServer&) = delete;
+    PttServer(PttServer&&) = delete;
+    PttServer& operator=(PttServer&&) = delete;
+
+    // False if the port could not be bound
+    bool start();
+
+private:
+    uint16_t pPort;
+    Handler pHandler;
+
+    restinio::asio_ns::io_context pIo;
+    restinio::asio_ns::ip::udp::socket pSocket;
+    restinio::asio_ns::ip::udp::endpoint pSenderEndpoint;
+    // Larger than a packet, so that oversized datagrams are seen as such
+    std::array<uint8_t, kPttPacketSize * 4> pBuffer {};
+
+    std::thread pThread;
+
+    void receive();
+};
+}
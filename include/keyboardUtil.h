@@ -4,6 +4,10 @@
 #include <SDL_scancode.h>
 #include <SFML/Window/Keyboard.hpp>
 
+#ifdef __linux__
+#include <linux/input-event-codes.h>
+#endif
+
 class KeyboardUtil {
 public:
     inline static sf::Keyboard::Scancode convertFromSDLToSFML(SDL_Scancode scancode)
@@ -301,4 +305,295 @@ public:
             return sf::Keyboard::Scancode::Unknown;
         }
     }
-};
\ No newline at end of file
+
+#ifdef __linux__
+    // Linux input event code of a key, KEY_RESERVED when it has none
+    inline static int convertFromSFMLToEvdev(sf::Keyboard::Scancode scancode)
+    {
+        switch (scancode) {
+        case sf::Keyboard::Scancode::A:
+            return KEY_A;
+        case sf::Keyboard::Scancode::B:
+            return KEY_B;
+        case sf::Keyboard::Scancode::C:
+            return KEY_C;
+        case sf::Keyboard::Scancode::D:
+            return KEY_D;
+        case sf::Keyboard::Scancode::E:
+            return KEY_E;
+        case sf::Keyboard::Scancode::F:
+            return KEY_F;
+        case sf::Keyboard::Scancode::G:
+            return KEY_G;
+        case sf::Keyboard::Scancode::H:
+            return KEY_H;
+        case sf::Keyboard::Scancode::I:
+            return KEY_I;
+        case sf::Keyboard::Scancode::J:
+            return KEY_J;
+        case sf::Keyboard::Scancode::K:
+            return KEY_K;
+        case sf::Keyboard::Scancode::L:
+            return KEY_L;
+        case sf::Keyboard::Scancode::M:
+            return KEY_M;
+        case sf::Keyboard::Scancode::N:
+            return KEY_N;
+        case sf::Keyboard::Scancode::O:
+            return KEY_O;
+        case sf::Keyboard::Scancode::P:
+            return KEY_P;
+        case sf::Keyboard::Scancode::Q:
+            return KEY_Q;
+        case sf::Keyboard::Scancode::R:
+            return KEY_R;
+        case sf::Keyboard::Scancode::S:
+            return KEY_S;
+        case sf::Keyboard::Scancode::T:
+            return KEY_T;
+        case sf::Keyboard::Scancode::U:
+            return KEY_U;
+        case sf::Keyboard::Scancode::V:
+            return KEY_V;
+        case sf::Keyboard::Scancode::W:
+            return KEY_W;
+        case sf::Keyboard::Scancode::X:
+            return KEY_X;
+        case sf::Keyboard::Scancode::Y:
+            return KEY_Y;
+        case sf::Keyboard::Scancode::Z:
+            return KEY_Z;
+        case sf::Keyboard::Scancode::Num0:
+            return KEY_0;
+        case sf::Keyboard::Scancode::Numpad0:
+            return KEY_KP0;
+        case sf::Keyboard::Scancode::Num1:
+            return KEY_1;
+        case sf::Keyboard::Scancode::Numpad1:
+            return KEY_KP1;
+        case sf::Keyboard::Scancode::Num2:
+            return KEY_2;
+        case sf::Keyboard::Scancode::Numpad2:
+            return KEY_KP2;
+        case sf::Keyboard::Scancode::Num3:
+            return KEY_3;
+        case sf::Keyboard::Scancode::Numpad3:
+            return KEY_KP3;
+        case sf::Keyboard::Scancode::Num4:
+            return KEY_4;
+        case sf::Keyboard::Scancode::Numpad4:
+            return KEY_KP4;
+        case sf::Keyboard::Scancode::Num5:
+            return KEY_5;
+        case sf::Keyboard::Scancode::Numpad5:
+            return KEY_KP5;
+        case sf::Keyboard::Scancode::Num6:
+            return KEY_6;
+        case sf::Keyboard::Scancode::Numpad6:
+            return KEY_KP6;
+        case sf::Keyboard::Scancode::Num7:
+            return KEY_7;
+        case sf::Keyboard::Scancode::Numpad7:
+            return KEY_KP7;
+        case sf::Keyboard::Scancode::Num8:
+            return KEY_8;
+        case sf::Keyboard::Scancode::Numpad8:
+            return KEY_KP8;
+        case sf::Keyboard::Scancode::Num9:
+            return KEY_9;
+        case sf::Keyboard::Scancode::Numpad9:
+            return KEY_KP9;
+        case sf::Keyboard::Scancode::F1:
+            return KEY_F1;
+        case sf::Keyboard::Scancode::F2:
+            return KEY_F2;
+        case sf::Keyboard::Scancode::F3:
+            return KEY_F3;
+        case sf::Keyboard::Scancode::F4:
+            return KEY_F4;
+        case sf::Keyboard::Scancode::F5:
+            return KEY_F5;
+        case sf::Keyboard::Scancode::F6:
+            return KEY_F6;
+        case sf::Keyboard::Scancode::F7:
+            return KEY_F7;
+        case sf::Keyboard::Scancode::F8:
+            return KEY_F8;
+        case sf::Keyboard::Scancode::F9:
+            return KEY_F9;
+        case sf::Keyboard::Scancode::F10:
+            return KEY_F10;
+        case sf::Keyboard::Scancode::F11:
+            return KEY_F11;
+        case sf::Keyboard::Scancode::F12:
+            return KEY_F12;
+        case sf::Keyboard::Scancode::F13:
+            return KEY_F13;
+        case sf::Keyboard::Scancode::F14:
+            return KEY_F14;
+        case sf::Keyboard::Scancode::F15:
+            return KEY_F15;
+        case sf::Keyboard::Scancode::F16:
+            return KEY_F16;
+        case sf::Keyboard::Scancode::F17:
+            return KEY_F17;
+        case sf::Keyboard::Scancode::F18:
+            return KEY_F18;
+        case sf::Keyboard::Scancode::F19:
+            return KEY_F19;
+        case sf::Keyboard::Scancode::F20:
+            return KEY_F20;
+        case sf::Keyboard::Scancode::F21:
+            return KEY_F21;
+        case sf::Keyboard::Scancode::F22:
+            return KEY_F22;
+        case sf::Keyboard::Scancode::F23:
+            return KEY_F23;
+        case sf::Keyboard::Scancode::F24:
+            return KEY_F24;
+        case sf::Keyboard::Scancode::Enter:
+            return KEY_ENTER;
+        case sf::Keyboard::Scancode::Escape:
+            return KEY_ESC;
+        case sf::Keyboard::Scancode::Backspace:
+            return KEY_BACKSPACE;
+        case sf::Keyboard::Scancode::Tab:
+            return KEY_TAB;
+        case sf::Keyboard::Scancode::Space:
+            return KEY_SPACE;
+        case sf::Keyboard::Scancode::Hyphen:
+            return KEY_MINUS;
+        case sf::Keyboard::Scancode::Equal:
+            return KEY_EQUAL;
+        case sf::Keyboard::Scancode::LBracket:
+            return KEY_LEFTBRACE;
+        case sf::Keyboard::Scancode::RBracket:
+            return KEY_RIGHTBRACE;
+        case sf::Keyboard::Scancode::Backslash:
+            return KEY_BACKSLASH;
+        case sf::Keyboard::Scancode::Semicolon:
+            return KEY_SEMICOLON;
+        case sf::Keyboard::Scancode::Apostrophe:
+            return KEY_APOSTROPHE;
+        case sf::Keyboard::Scancode::Grave:
+            return KEY_GRAVE;
+        case sf::Keyboard::Scancode::Comma:
+            return KEY_COMMA;
+        case sf::Keyboard::Scancode::Period:
+            return KEY_DOT;
+        case sf::Keyboard::Scancode::Slash:
+            return KEY_SLASH;
+        case sf::Keyboard::Scancode::CapsLock:
+            return KEY_CAPSLOCK;
+        case sf::Keyboard::Scancode::PrintScreen:
+            return KEY_SYSRQ;
+        case sf::Keyboard::Scancode::ScrollLock:
+            return KEY_SCROLLLOCK;
+        case sf::Keyboard::Scancode::Pause:
+            return KEY_PAUSE;
+        case sf::Keyboard::Scancode::Insert:
+            return KEY_INSERT;
+        case sf::Keyboard::Scancode::Home:
+            return KEY_HOME;
+        case sf::Keyboard::Scancode::PageUp:
+            return KEY_PAGEUP;
+        case sf::Keyboard::Scancode::Delete:
+            return KEY_DELETE;
+        case sf::Keyboard::Scancode::End:
+            return KEY_END;
+        case sf::Keyboard::Scancode::PageDown:
+            return KEY_PAGEDOWN;
+        case sf::Keyboard::Scancode::Right:
+            return KEY_RIGHT;
+        case sf::Keyboard::Scancode::Left:
+            return KEY_LEFT;
+        case sf::Keyboard::Scancode::Down:
+            return KEY_DOWN;
+        case sf::Keyboard::Scancode::Up:
+            return KEY_UP;
+        case sf::Keyboard::Scancode::NumLock:
+            return KEY_NUMLOCK;
+        case sf::Keyboard::Scancode::NumpadDivide:
+            return KEY_KPSLASH;
+        case sf::Keyboard::Scancode::NumpadMultiply:
+            return KEY_KPASTERISK;
+        case sf::Keyboard::Scancode::NumpadMinus:
+            return KEY_KPMINUS;
+        case sf::Keyboard::Scancode::NumpadPlus:
+            return KEY_KPPLUS;
+        case sf::Keyboard::Scancode::NumpadEqual:
+            return KEY_KPEQUAL;
+        case sf::Keyboard::Scancode::NumpadEnter:
+            return KEY_KPENTER;
+        case sf::Keyboard::Scancode::NumpadDecimal:
+            return KEY_KPDOT;
+        case sf::Keyboard::Scancode::NonUsBackslash:
+            return KEY_102ND;
+        case sf::Keyboard::Scancode::Application:
+            return KEY_COMPOSE;
+        case sf::Keyboard::Scancode::Menu:
+            return KEY_MENU;
+        case sf::Keyboard::Scancode::Help:
+            return KEY_HELP;
+        case sf::Keyboard::Scancode::Select:
+            return KEY_SELECT;
+        case sf::Keyboard::Scancode::Redo:
+            return KEY_REDO;
+        case sf::Keyboard::Scancode::Undo:
+            return KEY_UNDO;
+        case sf::Keyboard::Scancode::Cut:
+            return KEY_CUT;
+        case sf::Keyboard::Scancode::Copy:
+            return KEY_COPY;
+        case sf::Keyboard::Scancode::Paste:
+            return KEY_PASTE;
+        case sf::Keyboard::Scancode::VolumeMute:
+            return KEY_MUTE;
+        case sf::Keyboard::Scancode::VolumeUp:
+            return KEY_VOLUMEUP;
+        case sf::Keyboard::Scancode::VolumeDown:
+            return KEY_VOLUMEDOWN;
+        case sf::Keyboard::Scancode::MediaPlayPause:
+            return KEY_PLAYPAUSE;
+        case sf::Keyboard::Scancode::MediaStop:
+            return KEY_STOPCD;
+        case sf::Keyboard::Scancode::MediaNextTrack:
+            return KEY_NEXTSONG;
+        case sf::Keyboard::Scancode::MediaPreviousTrack:
+            return KEY_PREVIOUSSONG;
+        case sf::Keyboard::Scancode::LControl:
+            return KEY_LEFTCTRL;
+        case sf::Keyboard::Scancode::LShift:
+            return KEY_LEFTSHIFT;
+        case sf::Keyboard::Scancode::LAlt:
+            return KEY_LEFTALT;
+        case sf::Keyboard::Scancode::LSystem:
+            return KEY_LEFTMETA;
+        case sf::Keyboard::Scancode::RControl:
+            return KEY_RIGHTCTRL;
+        case sf::Keyboard::Scancode::RShift:
+            return KEY_RIGHTSHIFT;
+        case sf::Keyboard::Scancode::RAlt:
+            return KEY_RIGHTALT;
+        case sf::Keyboard::Scancode::RSystem:
+            return KEY_RIGHTMETA;
+        case sf::Keyboard::Scancode::Back:
+            return KEY_BACK;
+        case sf::Keyboard::Scancode::Forward:
+            return KEY_FORWARD;
+        case sf::Keyboard::Scancode::Refresh:
+            return KEY_REFRESH;
+        case sf::Keyboard::Scancode::Stop:
+            return KEY_STOP;
+        case sf::Keyboard::Scancode::Search:
+            return KEY_SEARCH;
+        case sf::Keyboard::Scancode::Favorites:
+            return KEY_BOOKMARKS;
+        case sf::Keyboard::Scancode::HomePage:
+            return KEY_HOMEPAGE;
+        default:
+            return KEY_RESERVED;
+        }
+    }
+#endif
+};
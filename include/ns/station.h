@@ -1,6 +1,9 @@
 #pragma once
 
+#include "channels.h"
+
 #include <nlohmann/detail/macro_scope.hpp>
+#include <algorithm>
 #include <nlohmann/json.hpp>
 #include <string>
 
@@ -13,7 +16,22 @@ public:
 
     [[nodiscard]] inline int getTransceiverCount() const { return pTransceiverCount; }
     [[nodiscard]] inline bool hasTransceiver() const { return pTransceiverCount > 0; }
-    inline void setTransceiverCount(int count) { pTransceiverCount = count; }
+    inline void setTransceiverCount(int count)
+    {
+        if (count != pTransceiverCount) {
+            pTransceiverCount = count;
+            buildSpeakerLabel();
+        }
+    }
+
+    // ImGui labels and IDs, built once instead of on every frame
+    [[nodiscard]] inline const std::string& getFrequencyLabel() const { return pFrequencyLabel; }
+    [[nodiscard]] inline const std::string& getRxLabel() const { return pRxLabel; }
+    [[nodiscard]] inline const std::string& getXcLabel() const { return pXcLabel; }
+    [[nodiscard]] inline const std::string& getTxLabel() const { return pTxLabel; }
+    [[nodiscard]] inline const std::string& getSpeakerLabel() const { return pSpeakerLabel; }
+    [[nodiscard]] inline const std::string& getRefreshLabel() const { return pRefreshLabel; }
+    [[nodiscard]] inline const std::string& getDeleteLabel() const { return pDeleteLabel; }
 
     inline static Station build(const std::string& callsign, int freqHz)
     {
@@ -21,8 +39,9 @@ public:
         s.pCallsign = std::move(callsign);
         s.pFrequencyHz = freqHz;
 
-        std::string temp = std::to_string(freqHz / 1000);
-        s.pHumanFreq = temp.substr(0, 3) + "." + temp.substr(3, 7);
+        s.pHumanFreq = vector_audio::channels::formatName(freqHz);
+
+        s.buildLabels();
 
         return s;
     }
@@ -35,5 +54,45 @@ protected:
     std::string pHumanFreq;
 
     int pTransceiverCount = -1;
+
+    std::string pFrequencyLabel;
+    std::string pRxLabel;
+    std::string pXcLabel;
+    std::string pTxLabel;
+    std::string pSpeakerLabel;
+    std::string pRefreshLabel;
+    std::string pDeleteLabel;
+
+    inline void buildLabels()
+    {
+        size_t callsignSize = pCallsign.length() / 2;
+        std::string paddedFreq
+            = std::string(
+                  callsignSize - std::min(callsignSize, pHumanFreq.length() / 2),
+                  ' ')
+            + pHumanFreq;
+        pFrequencyLabel = pCallsign + "\n" + paddedFreq;
+
+        pRxLabel = "RX##" + pCallsign;
+        pXcLabel = "XC##" + pCallsign;
+        pTxLabel = "TX##" + pCallsign;
+        pRefreshLabel = "Force Refresh##" + pCallsign;
+        pDeleteLabel = "Delete##" + pCallsign;
+
+        buildSpeakerLabel();
+    }
+
+    // Transceiver count right aligned on 3 characters, blank while unknown
+    inline void buildSpeakerLabel()
+    {
+        std::string transceiverCount = "   ";
+        if (pTransceiverCount != -1) {
+            transceiverCount = std::to_string(std::min(pTransceiverCount, 999));
+            if (transceiverCount.size() < 3)
+                transceiverCount.insert(0, 3 - transceiverCount.size(), ' ');
+        }
+
+        pSpeakerLabel = transceiverCount + "\nSPK##" + pCallsign;
+    }
 };
 }
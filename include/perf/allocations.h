@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace vector_audio::perf::allocations {
+
+/*
+ * Heap allocation counting. The global operator new is replaced in
+ * allocations.cpp, and ImGui is pointed at imguiAlloc()/imguiFree(), so both
+ * are counted per thread. Only linked into the application.
+ */
+
+// Allocations made by the calling thread since it started
+uint64_t thisThread();
+
+// For ImGui::SetAllocatorFunctions, before the context is created
+void* imguiAlloc(size_t size, void* userData);
+void imguiFree(void* ptr, void* userData);
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace vector_audio::perf {
+
+/*
+ * Monotonic arena for data that does not outlive a frame or an SDK request.
+ * Allocations are served from the inline buffer, and only go to the heap once
+ * it is full, which the allocation counter then shows. reset() hands the whole
+ * buffer back, nothing is freed individually.
+ */
+template <size_t Size>
+class Arena {
+public:
+    Arena()
+        : pResource(pBuffer.data(), pBuffer.size(),
+            std::pmr::new_delete_resource())
+    {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    [[nodiscard]] std::pmr::memory_resource* resource() { return &pResource; }
+
+    // Every container allocated from the arena must be gone by then
+    void reset() { pResource.release(); }
+
+private:
+    alignas(std::max_align_t) std::array<std::byte, Size> pBuffer;
+    std::pmr::monotonic_buffer_resource pResource;
+};
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "afv-native/event.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace vector_audio::perf {
+
+// Monotonic counters. Keep kCounterNames in counters.cpp in sync.
+enum class Counter {
+    kWebsocketMessagesSent, // Per client, a broadcast to 3 clients counts 3
+    kWebsocketBytesSent,
+    kDatafilePolls,
+    kDatafilePollFailures, // Download failed or returned a non 200 status
+    kVoiceReconnects, // Voice server came back after an unexpected drop
+    kPttStaleCommands, // External PTT commands dropped for their sequence
+    kCount
+};
+
+// Point in time values. Keep kGaugeNames in counters.cpp in sync.
+enum class Gauge {
+    kWebsocketClients,
+    kFrameHeapAllocations, // UI thread heap allocations in the last frame
+    kCount
+};
+
+// Highest afv_native::ClientEventType value, plus one
+constexpr size_t kAfvEventTypeCount
+    = static_cast<size_t>(afv_native::ClientEventType::AudioDeviceStoppedError)
+    + 1;
+
+void increment(Counter counter, uint64_t by = 1);
+uint64_t value(Counter counter);
+const char* counterName(Counter counter);
+
+void set(Gauge gauge, int64_t v);
+int64_t value(Gauge gauge);
+const char* gaugeName(Gauge gauge);
+
+void countAfvEvent(afv_native::ClientEventType evt);
+uint64_t afvEventCount(size_t eventIndex);
+const char* afvEventName(size_t eventIndex);
+}
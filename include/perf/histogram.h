@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace vector_audio::perf {
+
+/*
+ * Lock-free latency histogram with power of two buckets in microseconds.
+ * Bucket 0 holds samples below 1us, bucket i holds [2^(i-1), 2^i) us, and the
+ * last bucket collects everything above ~8.4s. Recording is a handful of
+ * relaxed atomic operations, safe from any thread.
+ */
+class Histogram {
+public:
+    static constexpr size_t kBucketCount = 25;
+
+    struct Snapshot {
+        std::array<uint64_t, kBucketCount> buckets {};
+        uint64_t count = 0;
+        uint64_t sumNs = 0;
+        uint64_t maxNs = 0;
+        uint64_t lastNs = 0;
+
+        [[nodiscard]] double meanUs() const
+        {
+            return count == 0 ? 0.0
+                              : static_cast<double>(sumNs)
+                    / static_cast<double>(count) / 1000.0;
+        }
+
+        // Upper bound of the bucket holding the q-th quantile, in microseconds
+        [[nodiscard]] double percentileUs(double q) const
+        {
+            if (count == 0) {
+                return 0.0;
+            }
+
+            auto target = static_cast<uint64_t>(
+                q * static_cast<double>(count - 1)) + 1;
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBucketCount; i++) {
+                seen += buckets[i];
+                if (seen >= target) {
+                    return std::min(bucketUpperBoundUs(i),
+                        static_cast<double>(maxNs) / 1000.0);
+                }
+            }
+            return static_cast<double>(maxNs) / 1000.0;
+        }
+    };
+
+    // Exclusive upper bound of a bucket, in microseconds
+    static constexpr double bucketUpperBoundUs(size_t bucket)
+    {
+        return static_cast<double>(uint64_t { 1 } << bucket);
+    }
+
+    void record(std::chrono::nanoseconds duration)
+    {
+        auto ns = static_cast<uint64_t>(std::max<int64_t>(0, duration.count()));
+
+        pBuckets[bucketFor(ns)].fetch_add(1, std::memory_order_relaxed);
+        pCount.fetch_add(1, std::memory_order_relaxed);
+        pSumNs.fetch_add(ns, std::memory_order_relaxed);
+        pLastNs.store(ns, std::memory_order_relaxed);
+
+        auto currentMax = pMaxNs.load(std::memory_order_relaxed);
+        while (ns > currentMax
+            && !pMaxNs.compare_exchange_weak(
+                currentMax, ns, std::memory_order_relaxed)) { }
+    }
+
+    [[nodiscard]] Snapshot snapshot() const
+    {
+        Snapshot s;
+        for (size_t i = 0; i < kBucketCount; i++) {
+            s.buckets[i] = pBuckets[i].load(std::memory_order_relaxed);
+        }
+        s.count = pCount.load(std::memory_order_relaxed);
+        s.sumNs = pSumNs.load(std::memory_order_relaxed);
+        s.maxNs = pMaxNs.load(std::memory_order_relaxed);
+        s.lastNs = pLastNs.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset()
+    {
+        for (auto& b : pBuckets) {
+            b.store(0, std::memory_order_relaxed);
+        }
+        pCount.store(0, std::memory_order_relaxed);
+        pSumNs.store(0, std::memory_order_relaxed);
+        pMaxNs.store(0, std::memory_order_relaxed);
+        pLastNs.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static size_t bucketFor(uint64_t ns)
+    {
+        uint64_t us = ns / 1000;
+        size_t bucket = 0;
+        while (us != 0 && bucket < kBucketCount - 1) {
+            us >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> pBuckets {};
+    std::atomic<uint64_t> pCount = 0;
+    std::atomic<uint64_t> pSumNs = 0;
+    std::atomic<uint64_t> pMaxNs = 0;
+    std::atomic<uint64_t> pLastNs = 0;
+};
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "perf/histogram.h"
+#include "perf/trace.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace vector_audio::perf {
+
+// Timed hot paths. Keep kMetricNames in instrumentation.cpp in sync.
+enum class Metric {
+    kFrameTime, // Whole main loop iteration, including vsync
+    kRenderFrame, // App::render_frame only
+    kEventCallback, // afv_native event callback
+    kDatafileDownload, // Slurper/datafile/status HTTP download
+    kDatafileParse, // Slurper/datafile parsing
+    kDatafilePoll, // One DataHandler worker poll, download and parse
+    kSdkHandler, // SDK HTTP request handlers
+    kWebsocketBroadcast, // SDK websocket broadcast to all clients
+    kPttEdge, // PTT input observed until SetPtt returned, on edges only
+    kRadioCommandBatch, // One RadioCommandQueue batch applied to afv_native
+    kPttExternal, // PTT datagram or websocket command received until SetPtt
+                  // returned, on edges only
+    kCount
+};
+
+using Clock = std::chrono::steady_clock;
+
+Histogram& histogram(Metric metric);
+
+const char* metricName(Metric metric);
+
+inline void record(Metric metric, std::chrono::nanoseconds duration)
+{
+    histogram(metric).record(duration);
+}
+
+/*
+ * Records the lifetime of the object into the histogram of the given metric,
+ * and as a span named after the metric when the trace recorder is running.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Metric metric)
+        : pMetric(metric)
+        , pStart(Clock::now())
+    {
+    }
+
+    ~ScopedTimer()
+    {
+        auto end = Clock::now();
+        record(pMetric, end - pStart);
+        if (trace::enabled()) {
+            trace::complete(metricName(pMetric), pStart, end);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    ScopedTimer(ScopedTimer&&) = delete;
+    ScopedTimer& operator=(ScopedTimer&&) = delete;
+
+private:
+    Metric pMetric;
+    Clock::time_point pStart;
+};
+
+/*
+ * Writes a one line summary per metric (count, mean, p50, p99, max) to the
+ * log at info level.
+ */
+void dumpToLog();
+
+void resetAll();
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+
+namespace vector_audio::perf {
+
+inline const std::string kOpenMetricsContentType
+    = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+/*
+ * Renders every histogram, counter, gauge and afv_native event count in the
+ * OpenMetrics text exposition format, ready to be scraped by Prometheus.
+ */
+std::string renderOpenMetrics();
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vector_audio::perf::startup {
+
+/*
+ * Startup timing report. Every stage is measured from markProcessStart(),
+ * called at the very top of main, until markFirstFrame(), called once the
+ * first interactive frame has been presented.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+struct Stage {
+    const char* name;
+    bool onMainThread;
+    int64_t beginUs;
+    int64_t durationUs;
+};
+
+void markProcessStart();
+
+// The name must be a string literal, it is also used as the trace span name
+void record(const char* name, Clock::time_point begin, Clock::time_point end);
+
+// Logs the breakdown the first time it is called, no-op afterwards
+void markFirstFrame();
+
+std::vector<Stage> stages();
+
+// Time to the first interactive frame, -1 until it has been presented
+int64_t firstFrameUs();
+
+class ScopedStage {
+public:
+    explicit ScopedStage(const char* name)
+        : pName(name)
+        , pStart(Clock::now())
+    {
+    }
+
+    ~ScopedStage() { record(pName, pStart, Clock::now()); }
+
+    ScopedStage(const ScopedStage&) = delete;
+    ScopedStage& operator=(const ScopedStage&) = delete;
+    ScopedStage(ScopedStage&&) = delete;
+    ScopedStage& operator=(ScopedStage&&) = delete;
+
+private:
+    const char* pName;
+    Clock::time_point pStart;
+};
+
+/*
+ * Small task graph for the startup sequence. A stage starts on its own
+ * thread as soon as all of its dependencies are done, dependencies must be
+ * added before the stages that need them. Anything touching the window, the
+ * renderer or ImGui has to stay on the main thread, use runHere for those.
+ *
+ * Exceptions thrown by a stage are logged and do not stop its dependents.
+ */
+class Pipeline {
+public:
+    Pipeline() = default;
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    Pipeline(Pipeline&&) = delete;
+    Pipeline& operator=(Pipeline&&) = delete;
+
+    void add(const char* name, std::function<void()> task,
+        const std::vector<std::string>& dependsOn = {});
+
+    // Runs a stage on the calling thread once its dependencies are done
+    void runHere(const char* name, const std::function<void()>& task,
+        const std::vector<std::string>& dependsOn = {});
+
+    void wait(const std::string& name);
+
+    void waitAll();
+
+private:
+    std::map<std::string, std::shared_future<void>> pStages;
+
+    void waitFor(const std::vector<std::string>& dependsOn);
+};
+}
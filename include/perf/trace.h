@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace vector_audio::perf::trace {
+
+/*
+ * Session timeline recorder writing Chrome trace_event JSON, which can be
+ * opened in Perfetto or chrome://tracing.
+ *
+ * Each thread appends to its own fixed size ring buffer, allocated on its
+ * first event, so recording never takes a lock. When a ring is full the
+ * oldest events are overwritten, so the file always holds the most recent
+ * part of the session.
+ */
+
+inline std::atomic<bool> recording = false;
+
+inline bool enabled() { return recording.load(std::memory_order_relaxed); }
+
+void start();
+
+// Names the calling thread in the trace, cheap to call repeatedly
+void setThreadName(const char* name);
+
+// Complete ("X") event. The name must be a string literal or otherwise
+// outlive the recorder.
+void complete(const char* name, std::chrono::steady_clock::time_point begin,
+    std::chrono::steady_clock::time_point end);
+
+// Instant ("i") event
+void instant(const char* name);
+
+// Writes every buffered event to the given file, returns false on IO error
+bool writeTo(const std::filesystem::path& path);
+}
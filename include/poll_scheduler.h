@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <random>
+
+namespace vector_audio::vatsim {
+
+/*
+ * Decides how long the DataHandler worker sleeps between two polls.
+ *
+ * Polls come every kFastInterval while a disconnect waits for its
+ * confirmation and for kFastWindow after the session state changed or a poll
+ * was requested. Otherwise they come every kIdleInterval while not
+ * connected and every kConnectedInterval once the session is stable. Endpoint
+ * failures back off exponentially up to kMaxBackoff. Every delay gets +/-10%
+ * of jitter so clients started together do not poll in lockstep.
+ */
+class PollScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Outcome {
+        kConnected,
+        kNotConnected,
+        kEndpointFailure,
+    };
+
+    static constexpr std::chrono::milliseconds kFastInterval { 3000 };
+    static constexpr std::chrono::milliseconds kIdleInterval { 10000 };
+    static constexpr std::chrono::milliseconds kConnectedInterval { 20000 };
+    static constexpr std::chrono::milliseconds kFastWindow { 30000 };
+    static constexpr std::chrono::milliseconds kBackoffBase { 5000 };
+    static constexpr std::chrono::milliseconds kMaxBackoff { 120000 };
+
+    // Returns the delay before the next poll
+    std::chrono::milliseconds next(
+        Outcome outcome, bool confirmationPending, Clock::time_point now)
+    {
+        if (outcome == Outcome::kEndpointFailure) {
+            pFailures = std::min(pFailures + 1, 16);
+            auto backoff = kBackoffBase * (1LL << (pFailures - 1));
+            return jitter(std::min<std::chrono::milliseconds>(
+                backoff, kMaxBackoff));
+        }
+        pFailures = 0;
+
+        if (pLastOutcome && *pLastOutcome != outcome) {
+            pFastUntil = now + kFastWindow;
+        }
+        pLastOutcome = outcome;
+
+        if (confirmationPending || now < pFastUntil) {
+            return jitter(kFastInterval);
+        }
+        return jitter(outcome == Outcome::kConnected ? kConnectedInterval
+                                                     : kIdleInterval);
+    }
+
+    // Polls fast for the next kFastWindow, e.g. after an explicit request
+    void expedite(Clock::time_point now) { pFastUntil = now + kFastWindow; }
+
+    [[nodiscard]] int consecutiveFailures() const { return pFailures; }
+
+private:
+    std::mt19937 pRng { std::random_device {}() };
+    int pFailures = 0;
+    std::optional<Outcome> pLastOutcome;
+    Clock::time_point pFastUntil;
+
+    std::chrono::milliseconds jitter(std::chrono::milliseconds delay)
+    {
+        std::uniform_real_distribution<double> factor(0.9, 1.1);
+        return std::chrono::milliseconds(static_cast<int64_t>(
+            static_cast<double>(delay.count()) * factor(pRng)));
+    }
+};
+}
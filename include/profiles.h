@@ -0,0 +1,38 @@
+#pragma once
+#include "audio/radio_state.h"
+
+#include <string>
+#include <string_view>
+#include <toml.hpp>
+#include <vector>
+
+namespace vector_audio::profiles {
+
+/*
+ * Saved station layouts, stored as [[profiles]] in config.toml. A profile is
+ * picked on connect by matching the session callsign against its pattern,
+ * where * stands for any run of characters and ? for a single one, so that
+ * "LFPG_*APP" covers every approach split of the same position.
+ */
+struct Profile {
+    std::string pattern;
+    int radioGain = 100;
+    std::vector<audio::StationState> stations;
+};
+
+// Case insensitive glob match of a callsign
+bool matches(std::string_view pattern, std::string_view callsign);
+
+// Malformed entries are skipped with a warning
+std::vector<Profile> load(const toml::value& config);
+
+// Replaces the [[profiles]] array of the config
+void store(toml::value& config, const std::vector<Profile>& profiles);
+
+// First profile matching the callsign, nullptr if there is none
+const Profile* find(
+    const std::vector<Profile>& profiles, std::string_view callsign);
+
+// Replaces the profile with the same pattern, or appends it
+void save(std::vector<Profile>& profiles, Profile profile);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <restinio/asio_include.hpp>
+#include <restinio/ip_blocker.hpp>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace vector_audio::sdk {
+
+/*
+ * ip_blocker of the HTTP server behind a LocalSocketRelay. The relay binds
+ * each of its connections before opening it and registers the endpoint
+ * here, so when the server is only meant to be reached through the socket
+ * every other connection is refused, and the mode of the socket file stays
+ * the only way in.
+ */
+class RelayPeers {
+public:
+    // Everything is allowed unless relayOnly
+    explicit RelayPeers(bool relayOnly);
+
+    restinio::ip_blocker::inspection_result_t inspect(
+        const restinio::ip_blocker::incoming_info_t& info) noexcept;
+
+    void add(const restinio::asio_ns::ip::tcp::endpoint& endpoint);
+    void remove(const restinio::asio_ns::ip::tcp::endpoint& endpoint);
+
+private:
+    bool pRelayOnly;
+    std::mutex pMutex;
+    std::set<restinio::asio_ns::ip::tcp::endpoint> pEndpoints;
+};
+
+/*
+ * Serves the SDK on a Unix domain socket. restinio only accepts TCP, so every
+ * connection on the socket is relayed byte for byte to the HTTP server on a
+ * loopback address, websocket upgrades included.
+ *
+ * Access is controlled by the mode of the socket file, which is set before
+ * the socket starts listening so that nobody can connect in between. The
+ * loopback side is registered with peers.
+ */
+class LocalSocketRelay {
+public:
+    LocalSocketRelay(std::filesystem::path path, unsigned int mode,
+        restinio::asio_ns::ip::tcp::endpoint target,
+        std::shared_ptr<RelayPeers> peers);
+    ~LocalSocketRelay();
+
+    LocalSocketRelay(const LocalSocketRelay&) = delete;
+    LocalSocketRelay& operator=(const LocalSocketRelay&) = delete;
+    LocalSocketRelay(LocalSocketRelay&&) = delete;
+    LocalSocketRelay& operator=(LocalSocketRelay&&) = delete;
+
+    // False if the socket could not be created, or the platform has none
+    bool start();
+
+    static bool isSupported();
+
+private:
+    std::filesystem::path pPath;
+    unsigned int pMode;
+    restinio::asio_ns::ip::tcp::endpoint pTarget;
+    std::shared_ptr<RelayPeers> pPeers;
+
+    restinio::asio_ns::io_context pIo;
+    std::thread pThread;
+    bool pBound = false;
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    restinio::asio_ns::local::stream_protocol::acceptor pAcceptor { pIo };
+
+    void accept();
+#endif
+
+    // Removes a socket file left behind by a crash, but not a live one
+    bool removeStale();
+};
+}
@@ -1,16 +1,28 @@
 #pragma once
 
-#include "absl/strings/str_join.h"
 #include "afv-native/atcClientWrapper.h"
 #include "afv-native/event.h"
+#include "audio/radio_commands.h"
+#include "audio/rx_history.h"
+#include "input/ptt_protocol.h"
 #include "ns/station.h"
+#include "perf/arena.h"
+#include "perf/counters.h"
+#include "perf/instrumentation.h"
+#include "perf/openmetrics.h"
+#include "perf/startup.h"
+#include "sdk/local_socket.h"
 #include "sdkWebsocketMessage.h"
 #include "shared.h"
 #include "util.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <restinio/all.hpp>
@@ -24,6 +36,7 @@
 #include <spdlog/spdlog.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace vector_audio {
 
@@ -36,6 +49,33 @@ namespace sdk::types {
         kRxEnd,
         kFrequencyStateUpdate,
     };
+
+    // Body of POST /session, sent by a radar client plugin on logon/logoff
+    struct SessionPush {
+        bool connected = false;
+        std::string callsign;
+        int frequencyHz = 0;
+        int facility = 0;
+        double latitude = 0.0;
+        double longitude = 0.0;
+    };
+
+    // One change requested on the control endpoints
+    struct ControlOperation {
+        enum class Kind { kAdd, kRemove, kSet, kGain };
+
+        Kind kind = Kind::kSet;
+        std::string callsign; // kAdd only
+        int frequencyHz = 0;
+        audio::RadioSwitches switches; // kAdd and kSet
+        int gain = 0; // kGain only, in percent like the gain slider
+    };
+
+    struct ControlResult {
+        std::string error; // Nothing was applied when set
+        uint64_t version = 0; // Radio state version that includes the request
+        bool applied = false; // False if the client had not caught up in time
+    };
 }
 
 class SDK {
@@ -46,6 +86,12 @@ public:
 
     bool start();
 
+    /**
+     * Closes the websockets and stops the server, waiting for the requests
+     * being handled. Nothing calls the handlers once it returns.
+     */
+    void stop();
+
     /**
      * Handles an AFV event for the websocket.
      *
@@ -57,30 +103,117 @@ public:
         const std::optional<int>& frequencyHz);
 
     static void loopCleanup(
-        const std::vector<std::string>& liveReceivedCallsigns);
+        const std::pmr::vector<std::pmr::string>& liveReceivedCallsigns);
+
+    /**
+     * Sets what POST /poll triggers, must be called before start().
+     *
+     * @param handler Asks for an immediate VATSIM connection status poll.
+     */
+    void setPollRequestHandler(std::function<void()> handler);
+
+    /**
+     * Sets what POST /session triggers, must be called before start().
+     * Pushes from other hosts are refused.
+     *
+     * @param handler Receives the validated session pushed by a plugin.
+     */
+    void setSessionPushHandler(
+        std::function<void(const sdk::types::SessionPush&)> handler);
+
+    /**
+     * Sets the history served on /history, which must outlive the server.
+     * Without one the endpoint answers 503.
+     */
+    void setRxHistory(const audio::RxHistory* history);
+
+    /**
+     * Sets what the control endpoints trigger, must be called before start().
+     * Without one they answer 503, requests from other hosts are refused.
+     *
+     * @param handler Validates and applies the operations of one request as a
+     * whole, they are either all applied or none is.
+     */
+    void setControlHandler(
+        std::function<sdk::types::ControlResult(
+            const std::vector<sdk::types::ControlOperation>&)>
+            handler);
+
+    using PttCommandHandler = std::function<void(
+        uint64_t, const input::PttCommand&, perf::Clock::time_point)>;
+
+    /**
+     * Sets what the kPtt and kTx websocket commands trigger, must be called
+     * before start(). They are ignored without one, and from other hosts.
+     *
+     * @param handler Receives the sender, the command and when it arrived,
+     * on the thread that read it.
+     */
+    void setPttCommandHandler(PttCommandHandler handler);
+
+    /**
+     * Sets what is called when a websocket closes, must be called before
+     * start().
+     *
+     * @param handler Receives the sender its PTT commands came from, on the
+     * thread that read the close.
+     */
+    void setPttSenderClosedHandler(std::function<void(uint64_t)> handler);
 
 private:
-    using serverTraits = restinio::traits_t<restinio::asio_timer_manager_t,
-        restinio::null_logger_t, restinio::router::express_router_t<>>;
+    struct serverTraits
+        : public restinio::traits_t<restinio::asio_timer_manager_t,
+              restinio::null_logger_t, restinio::router::express_router_t<>> {
+        using ip_blocker_t = sdk::RelayPeers;
+    };
 
     restinio::running_server_handle_t<serverTraits> pSDKServer;
+    std::unique_ptr<sdk::LocalSocketRelay> pLocalRelay;
+    std::shared_ptr<sdk::RelayPeers> pRelayPeers;
     std::shared_ptr<afv_native::api::atcClient> pClient;
+    std::function<void()> pPollRequestHandler;
+    std::function<void(const sdk::types::SessionPush&)> pSessionPushHandler;
+    const audio::RxHistory* pRxHistory = nullptr;
+    std::function<sdk::types::ControlResult(
+        const std::vector<sdk::types::ControlOperation>&)>
+        pControlHandler;
+    PttCommandHandler pPttCommandHandler;
+    std::function<void(uint64_t)> pPttSenderClosedHandler;
 
     using ws_registry_t
         = std::map<std::uint64_t, restinio::websocket::basic::ws_handle_t>;
 
+    // Touched from the restinio pool and the afv_native callback thread
+    std::mutex pWsRegistryMutex;
     ws_registry_t pWsRegistry;
 
+    // Stack arena for the temporaries of one request handler
+    static constexpr size_t kRequestArenaSize = 2 * 1024;
+
     enum sdkCall {
         kTransmitting,
         kRx,
         kTx,
         kWebSocket,
+        kMetrics,
+        kStartup,
+        kPoll,
+        kSession,
+        kHistory,
+        kStations,
+        kStation,
+        kGain,
+        kBatch,
     };
 
     static inline std::map<sdkCall, std::string> mSDKCallUrl
         = { { kTransmitting, "/transmitting" }, { kRx, "/rx" }, { kTx, "/tx" },
-              { kWebSocket, "/ws" } };
+              { kWebSocket, "/ws" }, { kMetrics, "/metrics" },
+              { kStartup, "/startup" }, { kPoll, "/poll" },
+              { kSession, "/session" }, { kHistory, "/history" },
+              { kStations, "/stations" },
+              { kStation, "/stations/:frequency" }, { kGain, "/gain" },
+              { kBatch, "/batch" } };
 
     /**
      * @brief Broadcasts data on the websocket.
@@ -91,6 +224,23 @@ private:
      */
     void broadcastOnWebsocket(const std::string& data);
 
+    /**
+     * Handles a text message from a websocket client, the only ones
+     * understood are the kPtt and kTx commands.
+     *
+     * @param connectionId The websocket the message came from.
+     * @param payload The message.
+     * @param receivedAt When the message was read.
+     */
+    void handleWebsocketCommand(std::uint64_t connectionId,
+        const std::string& payload, perf::Clock::time_point receivedAt);
+
+    /**
+     * The rx, tx and xc station lists of the frequency state update.
+     * Needs shared::fetchedStationMutex.
+     */
+    nlohmann::json frequencyState();
+
     /**
      * @brief Builds the server.
      *
@@ -141,5 +291,66 @@ private:
      */
     restinio::request_handling_status_t handleWebSocketSDKCall(
         const restinio::request_handle_t& req);
+
+    /**
+     * Handles the metrics SDK call, in the OpenMetrics text format.
+     *
+     * @param req The request handle.
+     * @return The status of the request handling.
+     */
+    static restinio::request_handling_status_t handleMetricsSDKCall(
+        const restinio::request_handle_t& req);
+
+    /**
+     * Handles the startup SDK call, returns the startup stage timings as JSON.
+     *
+     * @param req The request handle.
+     * @return The status of the request handling.
+     */
+    static restinio::request_handling_status_t handleStartupSDKCall(
+        const restinio::request_handle_t& req);
+
+    /**
+     * Handles the poll SDK call, wakes the VATSIM status poller.
+     *
+     * @param req The request handle.
+     * @return The status of the request handling.
+     */
+    restinio::request_handling_status_t handlePollSDKCall(
+        const restinio::request_handle_t& req);
+
+    /**
+     * Handles the session SDK call, a plugin pushing the VATSIM session.
+     *
+     * @param req The request handle.
+     * @return The status of the request handling.
+     */
+    restinio::request_handling_status_t handleSessionSDKCall(
+        const restinio::request_handle_t& req);
+
+    /**
+     * Handles the history SDK call, the received transmissions newer than
+     * the id given in "since".
+     *
+     * @param req The request handle.
+     * @return The status of the request handling.
+     */
+    restinio::request_handling_status_t handleHistorySDKCall(
+        const restinio::request_handle_t& req);
+
+    /**
+     * Handles the control SDK calls, POST /stations adds a station, POST
+     * and DELETE /stations/:frequency change or remove one, POST /gain sets
+     * the radio gain and POST /batch takes any number of these at once.
+     *
+     * @param req The request handle.
+     * @param kind The operation, nullopt for a batch.
+     * @param frequency The frequency from the path, if any.
+     * @return The status of the request handling.
+     */
+    restinio::request_handling_status_t handleControlSDKCall(
+        const restinio::request_handle_t& req,
+        std::optional<sdk::types::ControlOperation::Kind> kind,
+        std::optional<std::string> frequency = std::nullopt);
 };
 }
@@ -64,3 +64,11 @@ public:
 // JSON: {"type": "kFrequencyStateUpdate", "value": {"rx":
 // [{"pFrequencyHz": 118775000, "pCallsign": "EDDF_S_TWR"}], "tx": [{"pFrequencyHz": 119775000, "pCallsign": "EDDF_S_TWR"}], "xc":
 // [{"pFrequencyHz": 121500000, "pCallsign": "EDDF_S_TWR"}]}}
+
+//
+// Commands a client can send, for hardware panels and plugins:
+// @sequence increases with every command of the connection, older ones are
+// dropped. A client holding PTT must repeat kPtt at least every second.
+// JSON: {"type": "kPtt", "value": {"pressed": true, "sequence": 12}}
+// JSON: {"type": "kTx", "value": {"frequency": 119900000, "tx": true,
+// "sequence": 13}}
@@ -0,0 +1,43 @@
+#pragma once
+#include "sdk/vector_audio_state.h"
+
+#include <string>
+
+namespace vector_audio::sdk {
+
+/*
+ * Writes the radio state into the shared memory block described by
+ * vector_audio_state.h. Readers map it and copy it under the seqlock, there
+ * is no syscall and no serialisation on either side once it is mapped.
+ *
+ * publish() must always be called from the same thread.
+ */
+class StatePublisher {
+public:
+    StatePublisher(std::string name, unsigned int mode);
+    ~StatePublisher();
+
+    StatePublisher(const StatePublisher&) = delete;
+    StatePublisher& operator=(const StatePublisher&) = delete;
+    StatePublisher(StatePublisher&&) = delete;
+    StatePublisher& operator=(StatePublisher&&) = delete;
+
+    // False if the block could not be mapped, or the platform has none
+    bool start();
+
+    static bool isSupported();
+
+    // Only writes when the state differs from the last one published, the
+    // header fields of state are ignored
+    void publish(const va_state& state);
+
+private:
+    std::string pName;
+    unsigned int pMode;
+
+    va_state* pShared = nullptr;
+    va_state pLast {};
+
+    void write(const va_state& state);
+};
+}
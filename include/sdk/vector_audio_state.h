@@ -0,0 +1,105 @@
+/*
+ * Radio state published by VectorAudio in shared memory, for overlays and
+ * recorders that poll it. Plain C, readers only need this file.
+ *
+ * The block is the POSIX shared memory object VA_STATE_SHM_NAME, opened
+ * read only with shm_open() and mapped with mmap(). It is rewritten in place
+ * whenever the state changes, under a seqlock: the sequence is odd while a
+ * write is in progress, and a copy is only consistent when the sequence was
+ * even and the same before and after it. va_state_read() does exactly that.
+ *
+ * Strings are NUL terminated and truncated to fit. Readers must check the
+ * magic, version and size before trusting anything else.
+ */
+#ifndef VECTOR_AUDIO_STATE_H
+#define VECTOR_AUDIO_STATE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define VA_STATE_SHM_NAME "/vector_audio_state"
+#define VA_STATE_MAGIC 0x54534156u /* "VAST" */
+#define VA_STATE_VERSION 1u
+
+#define VA_STATE_MAX_STATIONS 32
+#define VA_STATE_MAX_RECEIVING 8
+#define VA_STATE_CALLSIGN_SIZE 16
+
+/* va_state_station.flags */
+#define VA_STATION_RX 0x01u
+#define VA_STATION_TX 0x02u
+#define VA_STATION_XC 0x04u
+#define VA_STATION_HEADSET 0x08u
+#define VA_STATION_RX_ACTIVE 0x10u /* somebody is transmitting on it */
+#define VA_STATION_TX_ACTIVE 0x20u /* we are transmitting on it */
+
+typedef struct va_state_station {
+    uint32_t frequency_hz;
+    uint32_t flags;
+    char callsign[VA_STATE_CALLSIGN_SIZE];
+    /* Last callsign heard on the frequency, live or not */
+    char last_received[VA_STATE_CALLSIGN_SIZE];
+} va_state_station;
+
+typedef struct va_state {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size; /* sizeof(va_state) of the writer */
+    uint32_t sequence; /* odd while being written */
+    uint32_t writer_pid;
+    /* Unix time of the last change, in milliseconds */
+    uint64_t updated_at_ms;
+
+    uint8_t connected; /* voice connected */
+    uint8_t ptt; /* PTT open */
+    uint8_t facility; /* 0 for observers */
+    uint8_t station_count;
+    uint8_t receiving_count;
+    uint8_t reserved[3];
+    uint32_t session_frequency_hz;
+    char callsign[VA_STATE_CALLSIGN_SIZE];
+
+    va_state_station stations[VA_STATE_MAX_STATIONS];
+    /* Callsigns transmitting right now, on any station we receive */
+    char receiving[VA_STATE_MAX_RECEIVING][VA_STATE_CALLSIGN_SIZE];
+} va_state;
+
+#if defined(__GNUC__) || defined(__clang__)
+/*
+ * Copies a consistent snapshot of the shared block into out. Returns 0 on
+ * success, -1 if the block is not a compatible VectorAudio state, and -2 if
+ * the writer kept it busy for all the attempts.
+ */
+static inline int va_state_read(const va_state* shared, va_state* out)
+{
+    int attempt;
+    for (attempt = 0; attempt < 64; attempt++) {
+        uint32_t before
+            = __atomic_load_n(&shared->sequence, __ATOMIC_ACQUIRE);
+        if (before & 1u) {
+            continue;
+        }
+        memcpy(out, (const void*)shared, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&shared->sequence, __ATOMIC_RELAXED) == before) {
+            if (out->magic != VA_STATE_MAGIC
+                || out->version != VA_STATE_VERSION
+                || out->size != sizeof(va_state)) {
+                return -1;
+            }
+            return 0;
+        }
+    }
+    return -2;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,4 +1,5 @@
 #pragma once
+#include "input/joystick_binding.h"
 #include "ns/station.h"
 #include "semver.hpp"
 
@@ -35,6 +36,8 @@ inline int defaultTransceiverPositionElevation = 300;
 inline int defaultSUPTransceiverPositionElevation = 1000;
 inline int airportTransceiverElevationOffset = 33;
 inline bool keepWindowOnTop = false;
+inline bool showPerfOverlay = false;
+inline bool showRxHistory = false;
 
 const int kObsFrequency = 199998000; // 199.998
 const int kUnicomFrequency = 122800000;
@@ -44,13 +47,19 @@ inline std::string configAudioApi;
 inline std::string configInputDeviceName;
 inline std::string configOutputDeviceName;
 inline std::string configSpeakerDeviceName;
+// Used when the configured device disappears while connected, empty for none
+inline std::string configFallbackInputDeviceName;
+inline std::string configFallbackOutputDeviceName;
 inline int headsetOutputChannel = 0;
 
 inline bool capturePttFlag = false;
+// Adds the next joystick button pressed as a binding, 0 for the general PTT
+inline bool captureJoystickFlag = false;
+inline int captureJoystickFrequencyHz = 0;
 
 inline sf::Keyboard::Scancode ptt = sf::Keyboard::Scan::Unknown;
-inline int joyStickId = -1;
-inline int joyStickPtt = -1;
+// Only touched from the UI thread
+inline std::vector<input::JoystickBinding> joystickBindings;
 inline bool isPttOpen = false;
 
 inline std::mutex fetchedStationMutex;
@@ -90,6 +99,16 @@ inline static std::chrono::high_resolution_clock::time_point
     currentlyTransmittingApiTimer;
 
 inline int apiServerPort = 49080;
+inline std::string apiServerAddress = "127.0.0.1";
+inline bool apiServerTcp = true; // false serves the SDK on apiSocketPath only
+inline std::string apiSocketPath; // empty disables the Unix domain socket
+inline unsigned int apiSocketMode = 0600;
+inline int pttServerPort = 49081; // 0 disables the PTT datagram input
+// Linux only, reads the PTT key from evdev rather than polling it
+inline bool evdevPtt = true;
+// Empty disables the shared memory radio state
+inline std::string stateShmName = "/vector_audio_state";
+inline unsigned int stateShmMode = 0600;
 
 // Thread unsafe stuff
 namespace session {
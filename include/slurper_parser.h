@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace vector_audio::vatsim::slurper {
+
+/*
+ * Allocation free parsing of the slurper CSV output. Every view returned
+ * points into the buffer given to the parser, which must outlive them.
+ *
+ * A line is cid,callsign,type,frequency,facility,latitude,longitude[,...]
+ */
+
+constexpr size_t kMinFields = 7;
+
+struct Connection {
+    std::string_view callsign;
+    std::string_view type;
+    std::string_view frequency;
+    std::string_view latitude;
+    std::string_view longitude;
+};
+
+// nullopt when the line has fewer than kMinFields fields
+std::optional<Connection> parseLine(std::string_view line);
+
+// Splits on '\n' and calls fn(const Connection&) for every well formed line
+// until fn returns false. Malformed lines are skipped.
+template <typename Fn> void forEachConnection(std::string_view data, Fn&& fn)
+{
+    while (!data.empty()) {
+        auto end = data.find('\n');
+        auto line = data.substr(0, end);
+        data.remove_prefix(end == std::string_view::npos ? data.size()
+                                                         : end + 1);
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (line.empty()) {
+            continue;
+        }
+
+        if (auto connection = parseLine(line)) {
+            if (!fn(*connection)) {
+                return;
+            }
+        }
+    }
+}
+
+// "118.500" -> 118500000, see channels::parseName. false when it is not a
+// channel name.
+bool parseFrequencyHz(std::string_view frequency, int& hz);
+
+// Sets out to 0.0 and returns false if value is not a number
+bool parseCoordinate(std::string_view value, double& out);
+
+// Parses the type as hexadecimal, so "atc" reads as 0xa and "pilot" fails
+std::optional<int> parseTypeCode(std::string_view type);
+}
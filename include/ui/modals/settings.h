@@ -1,9 +1,11 @@
 #pragma once
 #include "afv-native/atcClientWrapper.h"
+#include "channels.h"
 #include "config.h"
 #include "data_file_handler.h"
 #include "imgui.h"
 #include "imgui_internal.h"
+#include "input/joystick_ptt.h"
 #include "shared.h"
 #include "ui/style.h"
 #include "util.h"
@@ -20,5 +22,11 @@ public:
     static void render(
         const std::shared_ptr<afv_native::api::atcClient>& mClient,
         const std::function<void()>& playAlertSound);
+
+private:
+    // Frequency of the next joystick button added, empty for the general PTT
+    static inline std::string mJoystickFrequency;
+
+    static void renderJoystickBindings();
 };
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "shared.h"
 #include "ui/style.h"
 
-#include <absl/strings/str_join.h>
+#include <memory_resource>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -13,10 +13,17 @@ namespace vector_audio::ui::widgets {
 class LastRxWidget {
 
 public:
-    static void Draw(const std::vector<std::string>& receivedCallsigns)
+    // The text is built with the allocator of the list, the frame arena
+    static void Draw(
+        const std::pmr::vector<std::pmr::string>& receivedCallsigns)
     {
-        std::string rxList = "Last RX: ";
-        rxList.append(absl::StrJoin(receivedCallsigns, ", "));
+        std::pmr::string rxList("Last RX: ", receivedCallsigns.get_allocator());
+        for (size_t i = 0; i < receivedCallsigns.size(); i++) {
+            if (i > 0) {
+                rxList.append(", ");
+            }
+            rxList.append(receivedCallsigns[i]);
+        }
         ImGui::PushItemWidth(-1.0);
         ImGui::TextWrapped("%s", rxList.c_str());
         ImGui::PopItemWidth();
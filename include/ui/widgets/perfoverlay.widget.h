@@ -0,0 +1,81 @@
+#pragma once
+#include "imgui.h"
+#include "perf/counters.h"
+#include "perf/instrumentation.h"
+#include "shared.h"
+
+#include <cstddef>
+
+namespace vector_audio::ui::widgets {
+class PerfOverlayWidget {
+
+public:
+    // Toggled with Ctrl+Shift+P or from the settings panel
+    static void Draw()
+    {
+        if (ImGui::IsKeyChordPressed(
+                ImGuiMod_Ctrl | ImGuiMod_Shift | ImGuiKey_P)) {
+            shared::showPerfOverlay = !shared::showPerfOverlay;
+        }
+
+        if (!shared::showPerfOverlay) {
+            return;
+        }
+
+        ImGui::SetNextWindowBgAlpha(0.85F);
+        ImGui::SetNextWindowSize(ImVec2(520.0F, 0.0F), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Performance", &shared::showPerfOverlay,
+                ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings)) {
+            ImGui::End();
+            return;
+        }
+
+        if (ImGui::BeginTable("perf_table", 6,
+                ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+            ImGui::TableSetupColumn("Path (us)");
+            ImGui::TableSetupColumn("Count");
+            ImGui::TableSetupColumn("Last");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+
+            for (size_t i = 0; i < static_cast<size_t>(perf::Metric::kCount);
+                 i++) {
+                auto metric = static_cast<perf::Metric>(i);
+                auto s = perf::histogram(metric).snapshot();
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(perf::metricName(metric));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(s.count));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", static_cast<double>(s.lastNs) / 1000.0);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", s.percentileUs(0.50));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", s.percentileUs(0.99));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", static_cast<double>(s.maxNs) / 1000.0);
+            }
+            ImGui::EndTable();
+        }
+
+        // Measured by the main loop, zero is the goal once the UI is idle
+        ImGui::Text("Heap allocations last frame: %lld",
+            static_cast<long long>(
+                perf::value(perf::Gauge::kFrameHeapAllocations)));
+
+        if (ImGui::Button("Dump to log")) {
+            perf::dumpToLog();
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reset")) {
+            perf::resetAll();
+        }
+
+        ImGui::End();
+    }
+};
+}
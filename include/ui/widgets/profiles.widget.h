@@ -0,0 +1,43 @@
+#pragma once
+#include "imgui.h"
+#include "imgui_stdlib.h"
+#include "shared.h"
+#include "ui/style.h"
+
+#include <functional>
+#include <string>
+
+namespace vector_audio::ui::widgets {
+class ProfilesWidget {
+
+protected:
+    inline static std::string mPatternInputString;
+
+    const static ImGuiInputTextFlags kPatternInputFlags
+        = ImGuiInputTextFlags_AutoSelectAll
+        | ImGuiInputTextFlags_CharsUppercase;
+
+public:
+    // An empty pattern saves the profile for the session callsign only
+    static void Draw(bool isVoiceConnected, const std::string& activePattern,
+        const std::function<void(std::string)>& saveCallback)
+    {
+        ImGui::PushItemWidth(-1.0);
+        ImGui::Text("Profile");
+        if (!activePattern.empty()) {
+            ImGui::TextDisabled("Restored %s", activePattern.c_str());
+        }
+
+        style::push_disabled_on(!isVoiceConnected);
+        ImGui::InputTextWithHint("##ProfilePattern", "Callsign pattern, * ?",
+            &ProfilesWidget::mPatternInputString, kPatternInputFlags);
+        if (ImGui::Button("Save layout", ImVec2(-FLT_MIN, 0.0))
+            && isVoiceConnected) {
+            std::invoke(saveCallback, mPatternInputString);
+            ProfilesWidget::mPatternInputString.clear();
+        }
+        ImGui::PopItemWidth();
+        style::pop_disabled_on(!isVoiceConnected);
+    }
+};
+}
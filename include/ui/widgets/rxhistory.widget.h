@@ -0,0 +1,80 @@
+#pragma once
+#include "audio/rx_history.h"
+#include "channels.h"
+#include "imgui.h"
+#include "shared.h"
+
+#include <ctime>
+#include <vector>
+
+namespace vector_audio::ui::widgets {
+class RxHistoryWidget {
+
+protected:
+    // Reused every frame, so only the first copies allocate
+    inline static std::vector<audio::RxHistory::Entry> mEntries;
+
+public:
+    // Toggled from the button below the last RX list
+    static void Draw(const audio::RxHistory& history)
+    {
+        if (!shared::showRxHistory) {
+            return;
+        }
+
+        ImGui::SetNextWindowSize(ImVec2(420.0F, 300.0F), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("RX history", &shared::showRxHistory,
+                ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoSavedSettings)) {
+            ImGui::End();
+            return;
+        }
+
+        // The whole ring is copied so open transmissions get their duration
+        mEntries.clear();
+        history.copySince(0, mEntries);
+
+        if (ImGui::BeginTable("rx_history_table", 4,
+                ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV
+                    | ImGuiTableFlags_ScrollY)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Time");
+            ImGui::TableSetupColumn("Callsign");
+            ImGui::TableSetupColumn("Frequency");
+            ImGui::TableSetupColumn("Duration");
+            ImGui::TableHeadersRow();
+
+            // Newest first
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(mEntries.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd;
+                     row++) {
+                    const auto& entry = mEntries[mEntries.size() - 1 - row];
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    std::time_t start = entry.startMs / 1000;
+                    if (const std::tm* local = std::localtime(&start)) {
+                        ImGui::Text("%02d:%02d:%02d", local->tm_hour,
+                            local->tm_min, local->tm_sec);
+                    }
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(entry.callsign.data());
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(
+                        channels::formatName(entry.frequencyHz).c_str());
+                    ImGui::TableNextColumn();
+                    if (entry.isOpen()) {
+                        ImGui::TextUnformatted("live");
+                    } else {
+                        ImGui::Text("%.1fs", entry.durationMs / 1000.0);
+                    }
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+};
+}
@@ -8,9 +8,13 @@
 #include "util.h"
 
 #include <absl/strings/str_split.h>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <semver.hpp>
 #include <string>
 #include <thread>
@@ -20,7 +24,10 @@ namespace vector_audio {
 
 class Updater {
 public:
+    // Decides from the cached result of the last check, then checks the
+    // release endpoint in the background so the UI can start immediately
     Updater();
+    ~Updater();
 
     [[nodiscard]] bool need_update() const;
     void draw();
@@ -32,16 +39,32 @@ public:
         = "https://github.com/pierr3/VectorAudio/releases";
 
 private:
-    bool pNeedUpdate = false;
-    bool pIsBetaAvailable = false;
+    std::atomic<bool> pNeedUpdate = false;
 
     std::string pBaseUrl = "https://raw.githubusercontent.com";
     std::string pVersionUrl = "/pierr3/VectorAudio/main/VERSION";
     std::string pBetaVersionUrl = "/pierr3/VectorAudio/main/VERSION_BETA";
+    std::string pCacheFileName = "update_cache.toml";
+
+    // Guards pNewVersion and the shared:: beta fields, written by the check
+    // thread and read while drawing
+    inline static std::mutex mResultMutex;
     semver::version pNewVersion;
-    semver::version pBetaVersion;
 
     httplib::Client pCli;
+    std::unique_ptr<std::thread> pCheckThread;
+
+    void check_for_update();
+
+    std::optional<std::string> fetch_version(const std::string& url);
+
+    void apply_versions(const std::string& latestVersion,
+        const std::optional<std::string>& betaVersion);
+
+    void load_cache();
+
+    void save_cache(const std::string& latestVersion,
+        const std::optional<std::string>& betaVersion) const;
 };
 
 }
\ No newline at end of file
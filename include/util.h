@@ -1,6 +1,6 @@
 #pragma once
+#include "channels.h"
 #include "imgui.h"
-#include "radioSimulation.h"
 #include "shared.h"
 
 #include <afv-native/hardwareType.h>
@@ -117,7 +117,7 @@ inline int PlatformOpen(std::string cmd)
 #endif
 }
 
-inline void TextURL(const std::string& name_, std::string URL_)
+inline void TextURL(const std::string& name_, const std::string& URL_)
 {
     ImGui::PushStyleColor(
         ImGuiCol_Text, ImGui::GetStyle().Colors[ImGuiCol_ButtonHovered]);
@@ -126,7 +126,7 @@ inline void TextURL(const std::string& name_, std::string URL_)
 
     if (ImGui::IsItemHovered()) {
         if (ImGui::IsMouseClicked(0)) {
-            util::PlatformOpen(std::move(URL_));
+            util::PlatformOpen(URL_);
         }
         AddUnderLine(ImGui::GetStyle().Colors[ImGuiCol_ButtonHovered]);
     } else {
@@ -153,7 +153,7 @@ inline int cleanUpFrequency(int frequency)
         return frequency;
     }
 
-    return RadioSimulation::round8_33kHzChannel(frequency);
+    return channels::roundHz(frequency);
 }
 
 }
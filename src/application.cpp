@@ -1,13 +1,15 @@
 #include "application.h"
 
 #include "afv-native/event.h"
+#include "perf/startup.h"
 #include "shared.h"
 #include "util.h"
 
+#include <cstring>
 #include <filesystem>
+#include <map>
 #include <mutex>
 #include <optional>
-#include <SDL_joystick.h>
 #include <utility>
 
 namespace vector_audio::application {
@@ -15,8 +17,11 @@ using util::TextURL;
 
 App::App()
     : pDataHandler(std::make_unique<vatsim::DataHandler>())
+    , pLicensePath(
+          (Configuration::get_resource_folder() / "LICENSE.txt").string())
 {
     try {
+        perf::startup::ScopedStage stage("afv_client");
         afv_native::api::setLogger(
             [this](auto&& subsystem, auto&& file, auto&& line, auto&& lineOut) {
                 spdlog::info("[afv_native] [{}@{}] {} {}", file, line,
@@ -25,13 +30,6 @@ App::App()
 
         pClient = std::make_shared<afv_native::api::atcClient>(
             shared::kClientName, Configuration::get_resource_folder().string());
-
-        // Fetch all available devices on start
-        shared::availableAudioAPI = pClient->GetAudioApis();
-        shared::availableInputDevices
-            = pClient->GetAudioInputDevices(shared::mAudioApi);
-        shared::availableOutputDevices
-            = pClient->GetAudioOutputDevices(shared::mAudioApi);
         spdlog::debug("Created afv_native client.");
     } catch (std::exception& ex) {
         spdlog::critical(
@@ -39,7 +37,39 @@ App::App()
         return;
     }
 
+    // Panels and plugins drive PTT from their own threads, joysticks from
+    // the SDL events and the keyboard from render_frame()
+    pPtt = std::make_unique<input::PttController>(pClient, [this]() {
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+        pSDK->handleAFVEventForWebsocket(
+            sdk::types::Event::kFrequencyStateUpdate, std::nullopt,
+            std::nullopt);
+    });
+    pJoystickPtt = std::make_unique<input::JoystickPtt>(*pPtt);
+
     pSDK = std::make_unique<SDK>(pClient);
+    pSDK->setPollRequestHandler([this]() { pDataHandler->requestPoll(); });
+    pSDK->setRxHistory(&pRxHistory);
+    pSDK->setPttCommandHandler([this](uint64_t sender,
+                                   const input::PttCommand& command,
+                                   perf::Clock::time_point receivedAt) {
+        pPtt->handle(sender, command, receivedAt);
+    });
+    pSDK->setPttSenderClosedHandler(
+        [this](uint64_t sender) { pPtt->release(sender); });
+    pSDK->setControlHandler(
+        [this](const std::vector<sdk::types::ControlOperation>& operations) {
+            return applyControl(operations);
+        });
+    pSDK->setSessionPushHandler([this](const sdk::types::SessionPush& session) {
+        if (session.connected) {
+            pDataHandler->pushSessionConnected(session.callsign,
+                session.frequencyHz, session.facility, session.latitude,
+                session.longitude);
+        } else {
+            pDataHandler->pushSessionDisconnected();
+        }
+    });
 
     // Load all from config
     try {
@@ -62,18 +92,11 @@ App::App()
             toml::find_or<int>(cfg::mConfig, "user", "ptt",
                 static_cast<int>(sf::Keyboard::Scan::Unknown)));
 
-        shared::joyStickId = static_cast<int>(
-            toml::find_or<int>(cfg::mConfig, "user", "joyStickId", -1));
-        shared::joyStickPtt = static_cast<int>(
-            toml::find_or<int>(cfg::mConfig, "user", "joyStickPtt", -1));
+        shared::joystickBindings = input::loadJoystickBindings(cfg::mConfig);
 
-        auto audioProviders = pClient->GetAudioApis();
+        // Resolved to an API id from the first device enumeration
         shared::configAudioApi = toml::find_or<std::string>(
             cfg::mConfig, "audio", "api", std::string("Default API"));
-        for (const auto& driver : audioProviders) {
-            if (driver.second == shared::configAudioApi)
-                shared::mAudioApi = driver.first;
-        }
 
         shared::configInputDeviceName = toml::find_or<std::string>(
             cfg::mConfig, "audio", "input_device", std::string(""));
@@ -81,6 +104,10 @@ App::App()
             cfg::mConfig, "audio", "output_device", std::string(""));
         shared::configSpeakerDeviceName = toml::find_or<std::string>(
             cfg::mConfig, "audio", "speaker_device", std::string(""));
+        shared::configFallbackInputDeviceName = toml::find_or<std::string>(
+            cfg::mConfig, "audio", "fallback_input_device", std::string(""));
+        shared::configFallbackOutputDeviceName = toml::find_or<std::string>(
+            cfg::mConfig, "audio", "fallback_output_device", std::string(""));
         shared::headsetOutputChannel
             = toml::find_or<int>(cfg::mConfig, "audio", "headset_channel", 0);
 
@@ -94,11 +121,45 @@ App::App()
 
         shared::apiServerPort
             = toml::find_or<int>(cfg::mConfig, "general", "api_port", 49080);
+        shared::apiServerAddress = toml::find_or<std::string>(
+            cfg::mConfig, "general", "api_address", std::string("127.0.0.1"));
+        shared::apiServerTcp
+            = toml::find_or<bool>(cfg::mConfig, "general", "api_tcp", true);
+        shared::apiSocketPath = toml::find_or<std::string>(
+            cfg::mConfig, "general", "api_socket", std::string(""));
+        shared::apiSocketMode = toml::find_or<unsigned int>(
+            cfg::mConfig, "general", "api_socket_mode", 0600U);
+        shared::pttServerPort
+            = toml::find_or<int>(cfg::mConfig, "general", "ptt_port", 49081);
+        shared::evdevPtt
+            = toml::find_or<bool>(cfg::mConfig, "general", "evdev_ptt", true);
+        shared::stateShmName = toml::find_or<std::string>(cfg::mConfig,
+            "general", "state_shm", std::string("/vector_audio_state"));
+        shared::stateShmMode = toml::find_or<unsigned int>(
+            cfg::mConfig, "general", "state_shm_mode", 0600U);
+
+        pProfiles = profiles::load(cfg::mConfig);
     } catch (toml::exception& exc) {
         spdlog::error(
             "Failed to parse available configuration: {}", exc.what());
     }
 
+    // Devices are enumerated in the background, the settings panel and the
+    // connect button pick them up from syncAudioDevices()
+    pAudioDevicesApi = shared::mAudioApi;
+    pAudioDevices
+        = std::make_unique<audio::DeviceRegistry>(pClient, pAudioDevicesApi);
+
+    // Station toggles are applied off the UI thread, SDK clients hear about
+    // them once they went through
+    pRadioCommands = std::make_unique<audio::RadioCommandQueue>(
+        pClient, shared::radioGain / 100.0F, [this]() {
+            std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+            pSDK->handleAFVEventForWebsocket(
+                sdk::types::Event::kFrequencyStateUpdate, std::nullopt,
+                std::nullopt);
+        });
+
     pClient->RaiseClientEvent(
         [this](auto&& event_type, auto&& data_one, auto&& data_two) {
             eventCallbackWrapper(std::forward<decltype(event_type)>(event_type),
@@ -111,7 +172,38 @@ App::App()
         = std::chrono::high_resolution_clock::now();
 
     // Start the SDK server
-    auto _ = pSDK->start(); // Todo: display error if possible
+    {
+        perf::startup::ScopedStage stage("sdk_start");
+        auto _ = pSDK->start(); // Todo: display error if possible
+    }
+
+    if (shared::pttServerPort > 0) {
+        pPttServer = std::make_unique<input::PttServer>(
+            static_cast<uint16_t>(shared::pttServerPort),
+            [this](uint64_t sender, const input::PttCommand& command,
+                perf::Clock::time_point receivedAt) {
+                pPtt->handle(sender, command, receivedAt);
+            });
+        if (!pPttServer->start()) {
+            pPttServer.reset();
+        }
+    }
+
+    if (shared::evdevPtt && input::EvdevPtt::isSupported()) {
+        pEvdevPtt = std::make_unique<input::EvdevPtt>(*pPtt);
+        pEvdevPtt->setKey(shared::ptt);
+        if (!pEvdevPtt->start()) {
+            pEvdevPtt.reset();
+        }
+    }
+
+    if (!shared::stateShmName.empty()) {
+        pStatePublisher = std::make_unique<sdk::StatePublisher>(
+            shared::stateShmName, shared::stateShmMode);
+        if (!pStatePublisher->start()) {
+            pStatePublisher.reset();
+        }
+    }
 
     // Load the airport database async
     std::thread(&application::App::loadAirportsDatabaseAsync).detach();
@@ -134,8 +226,28 @@ App::~App()
     if (pClient && pClient->IsAPIConnected()) {
         disconnectAndCleanup();
     }
+    pPttServer.reset();
+    pStatePublisher.reset();
+    // Requests in flight call into the queue, its worker still reports to
+    // the SDK until it is reset
+    if (pSDK) {
+        pSDK->stop();
+    }
+    pRadioCommands.reset();
     pSDK.reset();
+    pJoystickPtt.reset();
+    pEvdevPtt.reset();
+    pPtt.reset();
+    pAudioDevices.reset();
     pClient.reset();
+
+    perf::dumpToLog();
+}
+
+bool App::isConnected() const
+{
+    return pClient
+        && (pClient->IsAPIConnected() || pClient->IsVoiceConnected());
 }
 
 void App::loadAirportsDatabaseAsync()
@@ -179,6 +291,9 @@ void App::loadAirportsDatabaseAsync()
 void App::eventCallbackWrapper(
     afv_native::ClientEventType evt, void* data, void* data2)
 {
+    perf::trace::setThreadName("afv_callback");
+    perf::ScopedTimer timer(perf::Metric::kEventCallback);
+    perf::countAfvEvent(evt);
     try {
         this->eventCallback(evt, data, data2);
     } catch (const std::bad_cast& e) {
@@ -250,13 +365,20 @@ void App::eventCallback(
                           "HTTP 403 or 401");
         }
 
+        if (err == afv_native::afv::APISessionError::ConnectionError
+            && pReconnectingVoice) {
+            // Still offline, tickVoiceReconnect() tries again later
+            spdlog::warn("Voice reconnect attempt failed to reach the API");
+            return;
+        }
+
         if (err == afv_native::afv::APISessionError::ConnectionError) {
             errorModal("Could not login to VATSIM.\nConnection "
                        "Error.\nCheck your internet connection.");
 
             spdlog::error("Got connection error from AFV API: local socket "
                           "or curl error");
-            disconnectAndCleanup();
+            pDisconnectRequested = true;
             playErrorSound();
         }
 
@@ -268,7 +390,7 @@ void App::eventCallback(
 
             spdlog::error("Got connection error from AFV API: HTTP 400 - "
                           "Bad Request or Client Incompatible");
-            disconnectAndCleanup();
+            pDisconnectRequested = true;
             playErrorSound();
         }
 
@@ -277,7 +399,7 @@ void App::eventCallback(
 
             spdlog::error("Got connection error from AFV API: Invalid Auth "
                           "Token Local Parse Error.");
-            disconnectAndCleanup();
+            pDisconnectRequested = true;
             playErrorSound();
         }
 
@@ -288,7 +410,7 @@ void App::eventCallback(
 
             spdlog::error("Got connection error from AFV API: Auth Token "
                           "Expiry in the past");
-            disconnectAndCleanup();
+            pDisconnectRequested = true;
             playErrorSound();
         }
 
@@ -297,49 +419,88 @@ void App::eventCallback(
 
             spdlog::error("Got connection error from AFV API: Unknown Error");
 
-            disconnectAndCleanup();
+            pDisconnectRequested = true;
             playErrorSound();
         }
     }
 
     if (evt == afv_native::ClientEventType::AudioError) {
+        if (pRecoveringAudio) {
+            // A restart attempt failed, tickAudioRecovery() retries it
+            spdlog::warn("Audio restart failed during device recovery");
+            return;
+        }
         errorModal("Error starting audio devices.\nPlease check "
                    "your log file for details.\nCheck your audio config!");
-        disconnectAndCleanup();
+        pDisconnectRequested = true;
+    }
+
+    if (evt == afv_native::ClientEventType::VoiceServerConnected) {
+        if (pAwaitingVoiceReconnect) {
+            perf::increment(perf::Counter::kVoiceReconnects);
+        }
+        pAwaitingVoiceReconnect = false;
     }
 
     if (evt == afv_native::ClientEventType::VoiceServerDisconnected) {
 
-        if (!pManuallyDisconnected) {
+        if (!pManuallyDisconnected && !pReconnectingVoice) {
             playErrorSound();
+            pAwaitingVoiceReconnect = true;
+            pVoiceReconnectRequested = true;
         }
 
         pManuallyDisconnected = false;
-        // disconnectAndCleanup();
     }
 
-    if (evt == afv_native::ClientEventType::VoiceServerError) {
+    // Once a session was up, voice server errors are usually transient and
+    // the session is rebuilt instead of being torn down
+    if (evt == afv_native::ClientEventType::VoiceServerError
+        || evt == afv_native::ClientEventType::VoiceServerChannelError) {
         int errCode = *reinterpret_cast<int*>(data);
-        errorModal("Voice server returned error " + std::to_string(errCode)
-            + ", please check the log file.");
-        disconnectAndCleanup();
-        playErrorSound();
-    }
+        std::string kind
+            = evt == afv_native::ClientEventType::VoiceServerError
+            ? "error"
+            : "channel error";
 
-    if (evt == afv_native::ClientEventType::VoiceServerChannelError) {
-        int errCode = *reinterpret_cast<int*>(data);
-        errorModal("Voice server returned channel error "
-            + std::to_string(errCode) + ", please check the log file.");
-        disconnectAndCleanup();
-        playErrorSound();
+        if (shared::bootUpVccs || pReconnectingVoice) {
+            spdlog::error(
+                "Voice server returned {} {}, reconnecting", kind, errCode);
+            if (!pReconnectingVoice) {
+                playErrorSound();
+            }
+            pVoiceReconnectRequested = true;
+        } else {
+            errorModal("Voice server returned " + kind + " "
+                + std::to_string(errCode) + ", please check the log file.");
+            pDisconnectRequested = true;
+            playErrorSound();
+        }
     }
 
-    if (evt == afv_native::ClientEventType::AudioDeviceStoppedError) {
-        errorModal("The audio device " + *reinterpret_cast<std::string*>(data)
-            + " has stopped working"
-              ", check if it is still physically connected.");
-        disconnectAndCleanup();
-        playErrorSound();
+    if (evt == afv_native::ClientEventType::AudioDeviceStoppedError
+        || evt == afv_native::ClientEventType::InputDeviceError) {
+        // Only AudioDeviceStoppedError carries the device name
+        std::string device
+            = evt == afv_native::ClientEventType::AudioDeviceStoppedError
+                && data != nullptr
+            ? *reinterpret_cast<std::string*>(data)
+            : shared::configInputDeviceName;
+
+        if (pClient->IsVoiceConnected()) {
+            // Keep the voice session and the frequencies, only audio is
+            // restarted once a usable device is back
+            spdlog::warn("Audio device {} stopped working, trying to recover",
+                device);
+            pAudioRecoveryRequested = true;
+        } else if (evt
+            == afv_native::ClientEventType::AudioDeviceStoppedError) {
+            errorModal("The audio device " + device
+                + " has stopped working"
+                  ", check if it is still physically connected.");
+            pDisconnectRequested = true;
+            playErrorSound();
+        }
     }
 
     if (evt == afv_native::ClientEventType::StationRxBegin) {
@@ -347,6 +508,8 @@ void App::eventCallback(
         // not only pilots
         if (data != nullptr && data2 != nullptr) {
             int frequency = *reinterpret_cast<int*>(data);
+            pRxHistory.begin(*reinterpret_cast<std::string*>(data2), frequency,
+                std::chrono::system_clock::now());
             std::string callsign = *reinterpret_cast<std::string*>(data2);
             spdlog::debug("Pilot {} opened RX", callsign);
             pSDK->handleAFVEventForWebsocket(
@@ -357,6 +520,8 @@ void App::eventCallback(
     if (evt == afv_native::ClientEventType::StationRxEnd) {
         if (data != nullptr && data2 != nullptr) {
             int frequency = *reinterpret_cast<int*>(data);
+            pRxHistory.end(*reinterpret_cast<std::string*>(data2), frequency,
+                std::chrono::system_clock::now());
             std::string callsign = *reinterpret_cast<std::string*>(data2);
             spdlog::debug("Pilot {} closed RX", callsign);
             pSDK->handleAFVEventForWebsocket(
@@ -396,46 +561,52 @@ void App::eventCallback(
 // Main loop
 void App::render_frame()
 {
+    perf::ScopedTimer timer(perf::Metric::kRenderFrame);
+
+    pFrameArena.reset();
+    std::pmr::memory_resource* frameMemory = pFrameArena.resource();
+
+    // Errors reported by afv_native tear the session down from here, the
+    // state it resets belongs to this thread
+    if (pDisconnectRequested.exchange(false)) {
+        disconnectAndCleanup();
+    }
+
+    syncAudioDevices();
+    tickAudioRecovery();
+    tickVoiceReconnect();
+
+    if (auto gain = pSdkRadioGain.exchange(-1); gain >= 0) {
+        shared::radioGain = gain;
+    }
+
     // AFV stuff
     if (pClient) {
         shared::mPeak = static_cast<float>(pClient->GetInputPeak());
         shared::mVu = static_cast<float>(pClient->GetInputVu());
 
-        // Set the Ptt if required, input based on event
-        if (pClient->IsVoiceConnected()
-            && (shared::ptt != sf::Keyboard::Scan::Unknown
-                || shared::joyStickId != -1)) {
-            if (shared::isPttOpen) {
-                if (shared::joyStickId != -1) {
-                    auto jButton = SDL_JoystickGetButton(
-                        SDL_JoystickFromInstanceID(shared::joyStickId),
-                        shared::joyStickPtt);
-                    if (jButton == 0) {
-                        shared::isPttOpen = false;
-                    }
-                } else {
-                    if (!sf::Keyboard::isKeyPressed(shared::ptt)) {
-                        shared::isPttOpen = false;
-                    }
-                }
-
-                pClient->SetPtt(shared::isPttOpen);
-            } else {
-                if (shared::joyStickId != -1) {
-                    auto jButton = SDL_JoystickGetButton(
-                        SDL_JoystickFromInstanceID(shared::joyStickId),
-                        shared::joyStickPtt);
-                    if (jButton == 1) {
-                        shared::isPttOpen = true;
-                    }
-                } else {
-                    if (sf::Keyboard::isKeyPressed(shared::ptt)) {
-                        shared::isPttOpen = true;
-                    }
-                }
-
-                pClient->SetPtt(shared::isPttOpen);
+        // Keyboard PTT, combined with the joysticks and the external senders
+        // by pPtt which only calls SetPtt on edges. With evdev the key is
+        // read on its own thread and only needs to be kept up to date, unless
+        // it has no evdev code
+        bool keyPolled = !pEvdevPtt || !pEvdevPtt->setKey(shared::ptt);
+        if (pKeyboardPolled && !keyPolled) {
+            pPtt->setLocal(input::PttController::LocalSource::kKeyboard,
+                false, perf::Clock::now());
+        }
+        pKeyboardPolled = keyPolled;
+        // Whatever the inputs do, a sender that went quiet is released
+        pPtt->expire(perf::Clock::now());
+        if (pClient->IsVoiceConnected()) {
+            if (keyPolled) {
+                auto pttPolledAt = perf::Clock::now();
+                bool keyPressed = shared::ptt != sf::Keyboard::Scan::Unknown
+                    && sf::Keyboard::isKeyPressed(shared::ptt);
+
+                pPtt->setLocal(input::PttController::LocalSource::kKeyboard,
+                    keyPressed, pttPolledAt);
             }
+            shared::isPttOpen = pPtt->isOpen();
         }
 
         {
@@ -456,29 +627,30 @@ void App::render_frame()
                 if (!frequencyExists(el.getFrequencyHz()))
                     shared::fetchedStations.push_back(el);
 
-                this->pClient->AddFrequency(
-                    shared::session::frequency, cleanCallsign);
-                pClient->SetEnableInputFilters(shared::mInputFilter);
-                pClient->SetEnableOutputEffects(shared::mOutputEffects);
-                this->pClient->UseTransceiversFromStation(
-                    cleanCallsign, shared::session::frequency);
-                this->pClient->SetRx(shared::session::frequency, true);
+                audio::RadioSwitches switches;
+                switches.rx = true;
                 if (shared::session::facility > 0) {
-                    this->pClient->SetTx(shared::session::frequency, true);
-                    this->pClient->SetXc(shared::session::frequency, true);
+                    switches.tx = true;
+                    switches.xc = true;
+                }
+                submitRadioCommand(
+                    shared::session::frequency, cleanCallsign, switches);
+
+                // Submitted in the same frame, so the whole layout goes out
+                // in a single batch
+                if (const auto* profile = profiles::find(
+                        pProfiles, shared::session::callsign)) {
+                    restoreProfile(*profile);
                 }
-                this->pSDK->handleAFVEventForWebsocket(
-                    sdk::types::Event::kFrequencyStateUpdate, std::nullopt,
-                    std::nullopt);
+
                 this->pClient->FetchStationVccs(cleanCallsign);
-                this->pClient->SetRadioGainAll(shared::radioGain / 100.0F);
             }
         }
     }
 
     // The live Received callsign data
-    std::vector<std::string> receivedCallsigns;
-    std::vector<std::string> liveReceivedCallsigns;
+    std::pmr::vector<std::pmr::string> receivedCallsigns(frameMemory);
+    std::pmr::vector<std::pmr::string> liveReceivedCallsigns(frameMemory);
 
     ImGui::SetNextWindowPos(ImVec2(0.0F, 0.0F));
     ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
@@ -489,14 +661,14 @@ void App::render_frame()
 
     // Callsign Field
     ImGui::PushItemWidth(100.0F);
-    std::string paddedCallsign = shared::session::callsign;
-    std::string notConnected = "Not connected";
-    if (paddedCallsign.length() < notConnected.length()) {
-        paddedCallsign.insert(paddedCallsign.end(),
-            notConnected.size() - paddedCallsign.size(), ' ');
-    }
-    ImGui::TextUnformatted(
-        std::string("Callsign: ").append(paddedCallsign).c_str());
+    std::pmr::string callsignText("Callsign: ", frameMemory);
+    callsignText.append(shared::session::callsign);
+    constexpr std::string_view kNotConnected = "Not connected";
+    if (shared::session::callsign.length() < kNotConnected.length()) {
+        callsignText.append(
+            kNotConnected.length() - shared::session::callsign.length(), ' ');
+    }
+    ImGui::TextUnformatted(callsignText.c_str());
     ImGui::PopItemWidth();
     ImGui::SameLine();
     ImGui::Text("|");
@@ -505,10 +677,12 @@ void App::render_frame()
 
     // Connect button logic
 
-    if (!pClient->IsVoiceConnected() && !pClient->IsAPIConnected()) {
-        bool readyToConnect = (!shared::session::isConnected
-                                  && pDataHandler->isSlurperAvailable())
-            || shared::session::isConnected;
+    if (!pReconnectingVoice && !pClient->IsVoiceConnected()
+        && !pClient->IsAPIConnected()) {
+        bool readyToConnect = ((!shared::session::isConnected
+                                   && pDataHandler->isSlurperAvailable())
+                                  || shared::session::isConnected)
+            && pAudioDevicesReady;
         style::push_disabled_on(!readyToConnect);
 
         if (ImGui::Button("Connect")) {
@@ -624,12 +798,11 @@ void App::render_frame()
     // Settings modal
     style::push_disabled_on(pClient->IsAPIConnected());
     if (ImGui::Button("Settings") && !pClient->IsAPIConnected()) {
-        // Update all available data
-        shared::availableAudioAPI = pClient->GetAudioApis();
-        shared::availableInputDevices
-            = pClient->GetAudioInputDevices(shared::mAudioApi);
-        shared::availableOutputDevices
-            = pClient->GetAudioOutputDevices(shared::mAudioApi);
+        // Opens on the cached lists, a fresh enumeration replaces them as
+        // soon as it completes
+        if (pAudioDevices) {
+            pAudioDevices->refresh();
+        }
         ImGui::OpenPopup("Settings Panel");
     }
     style::pop_disabled_on(pClient->IsAPIConnected());
@@ -656,258 +829,99 @@ void App::render_frame()
     ui::widgets::NetworkStatusWidget::Draw(pClient->IsVoiceConnected(),
         pDataHandler->isSlurperAvailable(),
         pDataHandler->isDatafileAvailable());
+    if (pReconnectingVoice) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("Reconnecting, attempt %d of %d",
+            pVoiceReconnectAttempts, kVoiceReconnectMaxAttempts);
+    }
     ImGui::NewLine();
 
     //
     // Main area
     //
 
-    ImGui::BeginGroup();
-    ImGuiTableFlags flags = ImGuiTableFlags_BordersOuter
-        | ImGuiTableFlags_BordersV | ImGuiTableFlags_NoBordersInBody
-        | ImGuiTableFlags_ScrollY;
-    if (ImGui::BeginTable("stations_table", 3, flags,
-            ImVec2(ImGui::GetContentRegionAvail().x * 0.8F, 0.0F))) {
-        int counter = -1;
-
+    // Received callsigns are gathered from every station, the grid below only
+    // draws the ones that are in view
+    {
         std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
-        for (auto& el : shared::fetchedStations) {
-            if (counter == -1 || counter == 4) {
-                counter = 1;
-                ImGui::TableNextRow();
-            }
-            ImGui::TableSetColumnIndex(counter - 1);
-
-            float halfHeight = ImGui::GetContentRegionAvail().x * 0.25F;
-            ImVec2 halfSize
-                = ImVec2(ImGui::GetContentRegionAvail().x * 0.50F, halfHeight);
-            ImVec2 quarterSize
-                = ImVec2(ImGui::GetContentRegionAvail().x * 0.25F, halfHeight);
-
-            ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 0.F);
-            ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.F);
-            ImGui::PushStyleColor(ImGuiCol_Button, ImColor(14, 17, 22).Value);
-
-            // Polling all data
-
-            bool rxState = pClient->GetRxState(el.getFrequencyHz());
-            bool rxActive = pClient->GetRxActive(el.getFrequencyHz());
-            bool txState = pClient->GetTxState(el.getFrequencyHz());
-            bool txActive = pClient->GetTxActive(el.getFrequencyHz());
-            bool xcState = pClient->GetXcState(el.getFrequencyHz());
-            bool isOnSpeaker = !pClient->GetOnHeadset(el.getFrequencyHz());
-            bool freqActive = pClient->IsFrequencyActive(el.getFrequencyHz())
-                && (rxState || txState || xcState);
-
-            //
-            // Frequency button
-            //
-            if (freqActive)
-                style::button_green();
-            // Disable the hover colour for this item
-            ImGui::PushStyleColor(
-                ImGuiCol_ButtonHovered, ImColor(14, 17, 22).Value);
-            size_t callsignSize = el.getCallsign().length() / 2;
-            std::string paddedFreq
-                = std::string(callsignSize
-                          - std::min(callsignSize,
-                              el.getHumanFrequency().length() / 2),
-                      ' ')
-                + el.getHumanFrequency();
-            std::string btnText = el.getCallsign() + "\n" + paddedFreq;
-            if (ImGui::Button(btnText.c_str(), halfSize))
-                ImGui::OpenPopup(el.getCallsign().c_str());
-            ImGui::SameLine(0.F, 0.01F);
-            ImGui::PopStyleColor();
-
-            //
-            // Frequency management popup
-            //
-            if (ImGui::BeginPopup(el.getCallsign().c_str())) {
-                ImGui::TextUnformatted(el.getCallsign().c_str());
-                ImGui::Separator();
-                if (ImGui::Selectable(std::string("Force Refresh##")
-                                          .append(el.getCallsign())
-                                          .c_str())) {
-                    pClient->FetchTransceiverInfo(el.getCallsign());
-                }
-                if (ImGui::Selectable(std::string("Delete##")
-                                          .append(el.getCallsign())
-                                          .c_str())) {
-                    pClient->RemoveFrequency(el.getFrequencyHz());
-
-                    shared::fetchedStations.erase(
-                        std::remove_if(shared::fetchedStations.begin(),
-                            shared::fetchedStations.end(),
-                            [el](ns::Station const& p) {
-                                return el.getFrequencyHz()
-                                    == p.getFrequencyHz();
-                            }),
-                        shared::fetchedStations.end());
-
-                    this->pSDK->handleAFVEventForWebsocket(
-                        sdk::types::Event::kFrequencyStateUpdate, std::nullopt,
-                        std::nullopt);
-                }
-                ImGui::EndPopup();
-            }
-
-            if (freqActive)
-                style::button_reset_colour();
-
-            //
-            // RX Button
-            //
-            if (rxState) {
-                // Set button colour
-                rxActive ? style::button_yellow() : style::button_green();
-
-                std::lock_guard<std::mutex> lock(shared::transmittingMutex);
-
-                auto receivedCld
-                    = pClient->LastTransmitOnFreq(el.getFrequencyHz());
-                if (!receivedCld.empty()
-                    && std::find(receivedCallsigns.begin(),
-                           receivedCallsigns.end(), receivedCld)
-                        == receivedCallsigns.end()) {
-                    receivedCallsigns.push_back(receivedCld);
-                }
-
-                // Here we filter not the last callsigns that transmitted, but
-                // only the ones that are currently transmitting
-                if (rxActive && !receivedCld.empty()
-                    && std::find(liveReceivedCallsigns.begin(),
-                           liveReceivedCallsigns.end(), receivedCld)
-                        == liveReceivedCallsigns.end()) {
-                    liveReceivedCallsigns.push_back(receivedCld);
-                }
-            }
-
-            if (ImGui::Button(
-                    std::string("RX##").append(el.getCallsign()).c_str(),
-                    halfSize)) {
-                if (freqActive) {
-                    pClient->SetRx(el.getFrequencyHz(), !rxState);
-                } else {
-                    pClient->AddFrequency(
-                        el.getFrequencyHz(), el.getCallsign());
-                    pClient->SetEnableInputFilters(shared::mInputFilter);
-                    pClient->SetEnableOutputEffects(shared::mOutputEffects);
-                    pClient->UseTransceiversFromStation(
-                        el.getCallsign(), el.getFrequencyHz());
-                    pClient->SetRx(el.getFrequencyHz(), true);
-                    pClient->SetRadioGainAll(shared::radioGain / 100.0F);
-                }
-                this->pSDK->handleAFVEventForWebsocket(
-                    sdk::types::Event::kFrequencyStateUpdate, std::nullopt,
-                    std::nullopt);
+        std::lock_guard<std::mutex> transmittingLock(shared::transmittingMutex);
+        receivedCallsigns.reserve(shared::fetchedStations.size());
+        liveReceivedCallsigns.reserve(shared::fetchedStations.size());
+        for (const auto& el : shared::fetchedStations) {
+            if (!pClient->GetRxState(el.getFrequencyHz()))
+                continue;
+
+            auto receivedCld = pClient->LastTransmitOnFreq(el.getFrequencyHz());
+            if (receivedCld.empty())
+                continue;
+
+            // The lists live in the frame arena, so compare through a view
+            std::string_view received = receivedCld;
+            if (std::find(receivedCallsigns.begin(), receivedCallsigns.end(),
+                    received)
+                == receivedCallsigns.end()) {
+                receivedCallsigns.emplace_back(received);
             }
 
-            if (rxState)
-                style::button_reset_colour();
-
-            ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 3);
-
-            // New line
-
-            //
-            // XC
-            //
-
-            if (xcState)
-                style::button_green();
-
-            if (ImGui::Button(
-                    std::string("XC##").append(el.getCallsign()).c_str(),
-                    quarterSize)
-                && shared::session::facility > 0) {
-                if (freqActive) {
-                    pClient->SetXc(el.getFrequencyHz(), !xcState);
-                } else {
-                    pClient->AddFrequency(
-                        el.getFrequencyHz(), el.getCallsign());
-                    pClient->SetEnableInputFilters(shared::mInputFilter);
-                    pClient->SetEnableOutputEffects(shared::mOutputEffects);
-                    pClient->UseTransceiversFromStation(
-                        el.getCallsign(), el.getFrequencyHz());
-                    pClient->SetTx(el.getFrequencyHz(), true);
-                    pClient->SetRx(el.getFrequencyHz(), true);
-                    pClient->SetXc(el.getFrequencyHz(), true);
-                    pClient->SetRadioGainAll(shared::radioGain / 100.0F);
-                }
-
-                this->pSDK->handleAFVEventForWebsocket(
-                    sdk::types::Event::kFrequencyStateUpdate, std::nullopt,
-                    std::nullopt);
+            // Here we filter not the last callsigns that transmitted, but
+            // only the ones that are currently transmitting
+            if (pClient->GetRxActive(el.getFrequencyHz())
+                && std::find(liveReceivedCallsigns.begin(),
+                       liveReceivedCallsigns.end(), received)
+                    == liveReceivedCallsigns.end()) {
+                liveReceivedCallsigns.emplace_back(received);
             }
+        }
+    }
 
-            if (xcState)
-                style::button_reset_colour();
-
-            ImGui::SameLine(0.F, 0.01F);
-
-            //
-            // Speaker device
-            //
-
-            if (isOnSpeaker)
-                style::button_green();
-
-            std::string transceiverCount
-                = std::to_string(std::min(el.getTransceiverCount(), 999));
-            if (transceiverCount.size() < 3)
-                transceiverCount.insert(0, 3 - transceiverCount.size(), ' ');
-
-            std::string speakerString
-                = el.getTransceiverCount() == -1 ? "   " : transceiverCount;
-            speakerString.append("\nSPK##");
-            speakerString.append(el.getCallsign());
-            if (ImGui::Button(speakerString.c_str(), quarterSize)) {
-                if (freqActive)
-                    pClient->SetOnHeadset(el.getFrequencyHz(), isOnSpeaker);
-            }
-
-            if (isOnSpeaker)
-                style::button_reset_colour();
-
-            ImGui::SameLine(0.F, 0.01F);
+    publishRadioState(liveReceivedCallsigns);
 
-            //
-            // TX
-            //
+    ImGui::BeginGroup();
+    ImGuiTableFlags flags = ImGuiTableFlags_BordersOuter
+        | ImGuiTableFlags_BordersV | ImGuiTableFlags_NoBordersInBody
+        | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("stations_table", kStationsPerRow, flags,
+            ImVec2(ImGui::GetContentRegionAvail().x * 0.8F, 0.0F))) {
+        std::optional<int> deletedFrequency;
 
-            if (txState)
-                txActive ? style::button_yellow() : style::button_green();
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
 
-            if (ImGui::Button(
-                    std::string("TX##").append(el.getCallsign()).c_str(),
-                    halfSize)
-                && shared::session::facility > 0) {
-                if (freqActive) {
-                    pClient->SetTx(el.getFrequencyHz(), !txState);
-                } else {
-                    pClient->AddFrequency(
-                        el.getFrequencyHz(), el.getCallsign());
-                    pClient->SetEnableInputFilters(shared::mInputFilter);
-                    pClient->SetEnableOutputEffects(shared::mOutputEffects);
-                    pClient->UseTransceiversFromStation(
-                        el.getCallsign(), el.getFrequencyHz());
-                    pClient->SetTx(el.getFrequencyHz(), true);
-                    pClient->SetRx(el.getFrequencyHz(), true);
-                    pClient->SetRadioGainAll(shared::radioGain / 100.0F);
+        // Only the rows in view are submitted, stations are laid out three
+        // per row
+        const int stationCount
+            = static_cast<int>(shared::fetchedStations.size());
+        ImGuiListClipper clipper;
+        clipper.Begin((stationCount + kStationsPerRow - 1) / kStationsPerRow);
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd;
+                 row++) {
+                ImGui::TableNextRow();
+                for (int column = 0; column < kStationsPerRow; column++) {
+                    const int index = row * kStationsPerRow + column;
+                    if (index >= stationCount)
+                        break;
+
+                    ImGui::TableSetColumnIndex(column);
+                    drawStation(shared::fetchedStations[index],
+                        deletedFrequency);
                 }
-                this->pSDK->handleAFVEventForWebsocket(
-                    sdk::types::Event::kFrequencyStateUpdate, std::nullopt,
-                    std::nullopt);
             }
+        }
 
-            if (txState)
-                style::button_reset_colour();
+        if (deletedFrequency) {
+            audio::RadioCommand command;
+            command.frequencyHz = *deletedFrequency;
+            command.remove = true;
+            pRadioCommands->submit(std::move(command));
 
-            ImGui::PopStyleColor();
-            ImGui::PopStyleVar(2);
+            shared::fetchedStations.erase(
+                std::remove_if(shared::fetchedStations.begin(),
+                    shared::fetchedStations.end(),
+                    [&](ns::Station const& p) {
+                        return *deletedFrequency == p.getFrequencyHz();
+                    }),
+                shared::fetchedStations.end());
 
-            counter++;
         }
 
         ImGui::EndTable();
@@ -929,10 +943,19 @@ void App::render_frame()
     ImGui::NewLine();
 
     ui::widgets::GainWidget::Draw(pClient->IsVoiceConnected(),
-        [&]() { pClient->SetRadioGainAll(shared::radioGain / 100.0F); });
+        [&]() { pRadioCommands->setRadioGain(shared::radioGain / 100.0F); });
+    ImGui::NewLine();
+
+    ui::widgets::ProfilesWidget::Draw(pClient->IsVoiceConnected(),
+        pActiveProfile, [&](std::string pattern) -> void {
+            saveProfile(std::move(pattern));
+        });
     ImGui::NewLine();
 
     ui::widgets::LastRxWidget::Draw(receivedCallsigns);
+    if (ImGui::SmallButton("RX history")) {
+        shared::showRxHistory = !shared::showRxHistory;
+    }
     ImGui::NewLine();
     ImGui::NewLine();
 
@@ -944,8 +967,7 @@ void App::render_frame()
 
     // Licenses
 
-    TextURL("Licenses",
-        (Configuration::get_resource_folder() / "LICENSE.txt").string());
+    TextURL("Licenses", pLicensePath);
 
     ImGui::EndGroup();
 
@@ -957,6 +979,364 @@ void App::render_frame()
     SDK::loopCleanup(liveReceivedCallsigns);
 
     ImGui::End();
+
+    ui::widgets::RxHistoryWidget::Draw(pRxHistory);
+    ui::widgets::PerfOverlayWidget::Draw();
+}
+
+void App::drawStation(
+    const ns::Station& el, std::optional<int>& deletedFrequency)
+{
+    float halfHeight = ImGui::GetContentRegionAvail().x * 0.25F;
+    ImVec2 halfSize
+        = ImVec2(ImGui::GetContentRegionAvail().x * 0.50F, halfHeight);
+    ImVec2 quarterSize
+        = ImVec2(ImGui::GetContentRegionAvail().x * 0.25F, halfHeight);
+
+    ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 0.F);
+    ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.F);
+    ImGui::PushStyleColor(ImGuiCol_Button, ImColor(14, 17, 22).Value);
+
+    // Polling all data, clicks that are still queued show as already applied
+
+    auto pending = pRadioCommands->pending(el.getFrequencyHz());
+    auto switches = pending.value_or(audio::RadioSwitches {});
+
+    bool rxState
+        = switches.rx.value_or(pClient->GetRxState(el.getFrequencyHz()));
+    bool rxActive = pClient->GetRxActive(el.getFrequencyHz());
+    bool txState
+        = switches.tx.value_or(pClient->GetTxState(el.getFrequencyHz()));
+    bool txActive = pClient->GetTxActive(el.getFrequencyHz());
+    bool xcState
+        = switches.xc.value_or(pClient->GetXcState(el.getFrequencyHz()));
+    bool isOnSpeaker = !switches.onHeadset.value_or(
+        pClient->GetOnHeadset(el.getFrequencyHz()));
+    bool freqActive
+        = (pending || pClient->IsFrequencyActive(el.getFrequencyHz()))
+        && (rxState || txState || xcState);
+
+    //
+    // Frequency button
+    //
+    if (freqActive)
+        style::button_green();
+    // Disable the hover colour for this item
+    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImColor(14, 17, 22).Value);
+    if (ImGui::Button(el.getFrequencyLabel().c_str(), halfSize))
+        ImGui::OpenPopup(el.getCallsign().c_str());
+    ImGui::SameLine(0.F, 0.01F);
+    ImGui::PopStyleColor();
+
+    //
+    // Frequency management popup
+    //
+    if (ImGui::BeginPopup(el.getCallsign().c_str())) {
+        ImGui::TextUnformatted(el.getCallsign().c_str());
+        ImGui::Separator();
+        if (ImGui::Selectable(el.getRefreshLabel().c_str())) {
+            pClient->FetchTransceiverInfo(el.getCallsign());
+        }
+        if (const auto* channel = channels::find(el.getFrequencyHz());
+            channel != nullptr && channel->is8_33kHz) {
+            ImGui::TextDisabled(
+                "8.33 kHz, carrier %.4f MHz", channel->carrierHz / 1e6);
+        }
+        if (ImGui::Selectable(el.getDeleteLabel().c_str())) {
+            // Erased once the grid is drawn, el is still in use
+            deletedFrequency = el.getFrequencyHz();
+        }
+        ImGui::EndPopup();
+    }
+
+    if (freqActive)
+        style::button_reset_colour();
+
+    //
+    // RX Button
+    //
+    if (rxState)
+        rxActive ? style::button_yellow() : style::button_green();
+
+    if (ImGui::Button(el.getRxLabel().c_str(), halfSize)) {
+        audio::RadioSwitches toggle;
+        toggle.rx = !freqActive || !rxState;
+        submitRadioCommand(el.getFrequencyHz(), el.getCallsign(), toggle);
+    }
+
+    if (rxState)
+        style::button_reset_colour();
+
+    ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 3);
+
+    // New line
+
+    //
+    // XC
+    //
+
+    if (xcState)
+        style::button_green();
+
+    if (ImGui::Button(el.getXcLabel().c_str(), quarterSize)
+        && shared::session::facility > 0) {
+        audio::RadioSwitches toggle;
+        if (freqActive) {
+            toggle.xc = !xcState;
+        } else {
+            toggle.tx = true;
+            toggle.rx = true;
+            toggle.xc = true;
+        }
+        submitRadioCommand(el.getFrequencyHz(), el.getCallsign(), toggle);
+    }
+
+    if (xcState)
+        style::button_reset_colour();
+
+    ImGui::SameLine(0.F, 0.01F);
+
+    //
+    // Speaker device
+    //
+
+    if (isOnSpeaker)
+        style::button_green();
+
+    if (ImGui::Button(el.getSpeakerLabel().c_str(), quarterSize)) {
+        if (freqActive) {
+            audio::RadioSwitches toggle;
+            toggle.onHeadset = isOnSpeaker;
+            submitRadioCommand(el.getFrequencyHz(), el.getCallsign(), toggle);
+        }
+    }
+
+    if (isOnSpeaker)
+        style::button_reset_colour();
+
+    ImGui::SameLine(0.F, 0.01F);
+
+    //
+    // TX
+    //
+
+    if (txState)
+        txActive ? style::button_yellow() : style::button_green();
+
+    if (ImGui::Button(el.getTxLabel().c_str(), halfSize)
+        && shared::session::facility > 0) {
+        audio::RadioSwitches toggle;
+        if (freqActive) {
+            toggle.tx = !txState;
+        } else {
+            toggle.tx = true;
+            toggle.rx = true;
+        }
+        submitRadioCommand(el.getFrequencyHz(), el.getCallsign(), toggle);
+    }
+
+    if (txState)
+        style::button_reset_colour();
+
+    ImGui::PopStyleColor();
+    ImGui::PopStyleVar(2);
+}
+
+audio::RadioCommand App::radioCommand(int frequencyHz, std::string callsign,
+    audio::RadioSwitches switches, bool useStationTransceivers)
+{
+    audio::RadioCommand command;
+    command.frequencyHz = frequencyHz;
+    command.callsign = std::move(callsign);
+    command.useStationTransceivers = useStationTransceivers;
+    command.inputFilter = shared::mInputFilter;
+    command.outputEffects = shared::mOutputEffects;
+    command.switches = switches;
+    return command;
+}
+
+void App::submitRadioCommand(int frequencyHz, std::string callsign,
+    audio::RadioSwitches switches, bool useStationTransceivers)
+{
+    pRadioCommands->submit(radioCommand(frequencyHz, std::move(callsign),
+        switches, useStationTransceivers));
+}
+
+void App::submitRadioState(const std::vector<audio::StationState>& states)
+{
+    for (const auto& state : states) {
+        if (!frequencyExists(state.frequencyHz)) {
+            shared::fetchedStations.push_back(
+                ns::Station::build(state.callsign, state.frequencyHz));
+        }
+
+        audio::RadioSwitches switches;
+        switches.rx = state.rx;
+        switches.tx = state.tx;
+        switches.xc = state.xc;
+        switches.onHeadset = state.onHeadset;
+        submitRadioCommand(state.frequencyHz, state.callsign, switches);
+    }
+    pRadioCommands->setRadioGain(shared::radioGain / 100.0F);
+}
+
+sdk::types::ControlResult App::applyControl(
+    const std::vector<sdk::types::ControlOperation>& operations)
+{
+    using Kind = sdk::types::ControlOperation::Kind;
+
+    sdk::types::ControlResult result;
+    if (!pClient->IsVoiceConnected()) {
+        result.error = "Voice is not connected";
+        return result;
+    }
+
+    std::vector<audio::RadioCommand> commands;
+    std::optional<int> gain;
+    {
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+
+        // Everything is checked before anything is applied, frequencies
+        // added or removed earlier in the same request count as such
+        std::map<int, bool> changed;
+        auto known = [&](int frequencyHz) {
+            auto it = changed.find(frequencyHz);
+            return it != changed.end() ? it->second
+                                       : frequencyExists(frequencyHz);
+        };
+        for (const auto& operation : operations) {
+            const auto& switches = operation.switches;
+            if (operation.kind == Kind::kGain) {
+                if (operation.gain < 0 || operation.gain > 200) {
+                    result.error = "gain must be between 0 and 200";
+                }
+            } else if (operation.kind == Kind::kAdd) {
+                if (operation.callsign.empty() || operation.frequencyHz <= 0
+                    || !channels::isValidKHz(operation.frequencyHz / 1000)) {
+                    result.error = "add needs a callsign and a valid frequency";
+                }
+                changed[operation.frequencyHz] = true;
+            } else if (!known(operation.frequencyHz)) {
+                result.error = "unknown frequency "
+                    + std::to_string(operation.frequencyHz);
+            } else if (operation.kind == Kind::kRemove) {
+                changed[operation.frequencyHz] = false;
+            }
+
+            if ((switches.tx.value_or(false) || switches.xc.value_or(false))
+                && shared::session::facility <= 0) {
+                result.error = "only controllers can transmit";
+            }
+            if (!result.error.empty()) {
+                return result;
+            }
+        }
+
+        for (const auto& operation : operations) {
+            auto station = std::find_if(shared::fetchedStations.begin(),
+                shared::fetchedStations.end(), [&](const ns::Station& s) {
+                    return s.getFrequencyHz() == operation.frequencyHz;
+                });
+
+            switch (operation.kind) {
+            case Kind::kAdd: {
+                if (station == shared::fetchedStations.end()) {
+                    shared::fetchedStations.push_back(ns::Station::build(
+                        operation.callsign, operation.frequencyHz));
+                }
+                auto switches = operation.switches;
+                if (!switches.rx && !switches.tx && !switches.xc) {
+                    switches.rx = true;
+                }
+                commands.push_back(radioCommand(
+                    operation.frequencyHz, operation.callsign, switches));
+                break;
+            }
+            case Kind::kSet:
+                if (station == shared::fetchedStations.end()) {
+                    break;
+                }
+                commands.push_back(radioCommand(operation.frequencyHz,
+                    station->getCallsign(), operation.switches));
+                break;
+            case Kind::kRemove: {
+                if (station == shared::fetchedStations.end()) {
+                    break;
+                }
+                audio::RadioCommand command;
+                command.frequencyHz = operation.frequencyHz;
+                command.remove = true;
+                commands.push_back(std::move(command));
+                shared::fetchedStations.erase(station);
+                break;
+            }
+            case Kind::kGain:
+                gain = operation.gain;
+                break;
+            }
+        }
+    }
+
+    // The gain goes first, so that the station commands are never applied
+    // before it
+    if (gain) {
+        pSdkRadioGain = *gain;
+        result.version = pRadioCommands->setRadioGain(*gain / 100.0F);
+    }
+    if (!commands.empty()) {
+        result.version = pRadioCommands->submit(std::move(commands));
+    }
+
+    // Outside of fetchedStationMutex, the worker takes it once done
+    result.applied
+        = pRadioCommands->waitApplied(result.version, kControlApplyTimeout);
+    return result;
+}
+
+void App::restoreProfile(const profiles::Profile& profile)
+{
+    for (const auto& state : profile.stations) {
+        if (!frequencyExists(state.frequencyHz)) {
+            shared::fetchedStations.push_back(
+                ns::Station::build(state.callsign, state.frequencyHz));
+        }
+
+        // Only controllers may transmit, whatever the profile says
+        audio::RadioSwitches switches;
+        switches.rx = state.rx;
+        switches.tx = state.tx && shared::session::facility > 0;
+        switches.xc = state.xc && shared::session::facility > 0;
+        switches.onHeadset = state.onHeadset;
+        submitRadioCommand(state.frequencyHz, state.callsign, switches);
+    }
+
+    shared::radioGain = profile.radioGain;
+    pRadioCommands->setRadioGain(shared::radioGain / 100.0F);
+    pActiveProfile = profile.pattern;
+
+    spdlog::info("Restored profile {} with {} stations", profile.pattern,
+        profile.stations.size());
+}
+
+void App::saveProfile(std::string pattern)
+{
+    profiles::Profile profile;
+    profile.pattern
+        = pattern.empty() ? shared::session::callsign : std::move(pattern);
+    profile.radioGain = shared::radioGain;
+    {
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+        profile.stations
+            = audio::captureRadioState(*pClient, shared::fetchedStations);
+    }
+
+    spdlog::info("Saved profile {} with {} stations", profile.pattern,
+        profile.stations.size());
+
+    pActiveProfile = profile.pattern;
+    profiles::save(pProfiles, std::move(profile));
+    profiles::store(Configuration::mConfig, pProfiles);
+    Configuration::write_config_async();
 }
 
 void App::errorModal(std::string message)
@@ -974,12 +1354,315 @@ bool App::frequencyExists(int freq)
         != shared::fetchedStations.end();
 }
 
+void App::syncAudioDevices()
+{
+    if (!pAudioDevices) {
+        return;
+    }
+
+    if (shared::mAudioApi != pAudioDevicesApi) {
+        pAudioDevicesApi = shared::mAudioApi;
+        pAudioDevices->refresh(pAudioDevicesApi);
+    }
+
+    auto devices = pAudioDevices->snapshot();
+    if (!devices || devices->generation == pAudioDevicesGeneration) {
+        return;
+    }
+    pAudioDevicesGeneration = devices->generation;
+    shared::availableAudioAPI = devices->audioApis;
+
+    // The first enumeration runs on the default API, the configured one is
+    // only known by name until the list of APIs comes back
+    if (!pAudioApiResolved) {
+        pAudioApiResolved = true;
+        for (const auto& driver : devices->audioApis) {
+            if (driver.second == shared::configAudioApi) {
+                shared::mAudioApi = driver.first;
+            }
+        }
+        if (shared::mAudioApi != pAudioDevicesApi) {
+            pAudioDevicesApi = shared::mAudioApi;
+            pAudioDevices->refresh(pAudioDevicesApi);
+            return;
+        }
+    }
+
+    // Drop lists enumerated for an API that is no longer selected, the
+    // refresh above is already on its way
+    if (devices->audioApi != pAudioDevicesApi) {
+        return;
+    }
+
+    shared::availableInputDevices = devices->inputDevices;
+    shared::availableOutputDevices = devices->outputDevices;
+    pAudioDevicesReady = true;
+}
+
+namespace {
+    // The configured device if it is present, else the fallback if that is,
+    // else the first one like connecting does. nullopt when there is none
+    std::optional<std::string> pickAudioDevice(
+        const std::vector<std::string>& available, const std::string& configured,
+        const std::string& fallback)
+    {
+        for (const auto& name : { configured, fallback }) {
+            if (!name.empty()
+                && std::find(available.begin(), available.end(), name)
+                    != available.end()) {
+                return name;
+            }
+        }
+        if (!available.empty()) {
+            return available.front();
+        }
+        return std::nullopt;
+    }
+}
+
+void App::handleInputEvent(const SDL_Event& event)
+{
+    if (pJoystickPtt) {
+        pJoystickPtt->handleEvent(event);
+    }
+}
+
+namespace {
+    template <size_t N>
+    void copyCallsign(char (&target)[N], std::string_view callsign)
+    {
+        auto size = std::min(callsign.size(), N - 1);
+        std::memcpy(target, callsign.data(), size);
+        target[size] = '\0';
+    }
+}
+
+void App::publishRadioState(
+    const std::pmr::vector<std::pmr::string>& liveReceivedCallsigns)
+{
+    if (!pStatePublisher) {
+        return;
+    }
+
+    va_state state {};
+    state.connected = pClient->IsVoiceConnected() ? 1 : 0;
+    state.ptt = shared::isPttOpen ? 1 : 0;
+    if (shared::session::isConnected) {
+        state.facility = static_cast<uint8_t>(
+            std::clamp(shared::session::facility, 0, 255));
+        state.session_frequency_hz
+            = static_cast<uint32_t>(shared::session::frequency);
+        copyCallsign(state.callsign, shared::session::callsign);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+        for (const auto& el : shared::fetchedStations) {
+            if (state.station_count == VA_STATE_MAX_STATIONS) {
+                break;
+            }
+
+            auto frequency = el.getFrequencyHz();
+            auto& station = state.stations[state.station_count++];
+            station.frequency_hz = static_cast<uint32_t>(frequency);
+            copyCallsign(station.callsign, el.getCallsign());
+
+            uint32_t flags = 0;
+            flags |= pClient->GetRxState(frequency) ? VA_STATION_RX : 0;
+            flags |= pClient->GetTxState(frequency) ? VA_STATION_TX : 0;
+            flags |= pClient->GetXcState(frequency) ? VA_STATION_XC : 0;
+            flags |= pClient->GetOnHeadset(frequency) ? VA_STATION_HEADSET : 0;
+            flags |= pClient->GetRxActive(frequency) ? VA_STATION_RX_ACTIVE : 0;
+            flags |= pClient->GetTxActive(frequency) ? VA_STATION_TX_ACTIVE : 0;
+            station.flags = flags;
+
+            if ((flags & VA_STATION_RX) != 0) {
+                copyCallsign(station.last_received,
+                    pClient->LastTransmitOnFreq(frequency));
+            }
+        }
+    }
+
+    for (const auto& callsign : liveReceivedCallsigns) {
+        if (state.receiving_count == VA_STATE_MAX_RECEIVING) {
+            break;
+        }
+        copyCallsign(state.receiving[state.receiving_count++], callsign);
+    }
+
+    pStatePublisher->publish(state);
+}
+
+void App::tickAudioRecovery()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    if (pAudioRecoveryRequested.exchange(false) && !pRecoveringAudio) {
+        {
+            std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+            pAudioRecoveryState
+                = audio::captureRadioState(*pClient, shared::fetchedStations);
+        }
+        pClient->StopAudio();
+        pRecoveringAudio = true;
+        pAudioRecoveryStarted = now;
+        pAudioRecoveryLastAttempt = {};
+        playErrorSound();
+    }
+
+    if (!pRecoveringAudio) {
+        return;
+    }
+
+    if (!pClient->IsVoiceConnected()) {
+        // The session went away on its own, nothing left to restore
+        pRecoveringAudio = false;
+        pAudioRecoveryState.clear();
+        return;
+    }
+
+    if (now - pAudioRecoveryLastAttempt < kAudioRecoveryRetryInterval) {
+        return;
+    }
+    pAudioRecoveryLastAttempt = now;
+
+    auto input = pickAudioDevice(shared::availableInputDevices,
+        shared::configInputDeviceName, shared::configFallbackInputDeviceName);
+    auto output = pickAudioDevice(shared::availableOutputDevices,
+        shared::configOutputDeviceName, shared::configFallbackOutputDeviceName);
+
+    if (!input || !output) {
+        if (now - pAudioRecoveryStarted > kAudioRecoveryTimeout) {
+            pRecoveringAudio = false;
+            pAudioRecoveryState.clear();
+            errorModal("The audio device has stopped working and did not come "
+                       "back, check if it is still physically connected.");
+            disconnectAndCleanup();
+            playErrorSound();
+            return;
+        }
+        // Hotplug events do not cover every audio API, so poll as well
+        pAudioDevices->refresh();
+        return;
+    }
+
+    auto speaker = pickAudioDevice(shared::availableOutputDevices,
+        shared::configSpeakerDeviceName, *output);
+
+    pClient->SetAudioInputDevice(*input);
+    pClient->SetAudioOutputDevice(*output);
+    pClient->SetAudioSpeakersOutputDevice(speaker.value_or(*output));
+    pClient->StartAudio();
+    if (!pClient->IsAudioRunning()) {
+        return;
+    }
+
+    // Through the queue like any other change, so the restore cannot race
+    // a batch it is applying
+    {
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+        submitRadioState(pAudioRecoveryState);
+    }
+    pRecoveringAudio = false;
+
+    spdlog::info("Audio recovered on {} / {} after {}ms, restored {} stations",
+        *input, *output,
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - pAudioRecoveryStarted)
+            .count(),
+        pAudioRecoveryState.size());
+    pAudioRecoveryState.clear();
+}
+
+void App::tickVoiceReconnect()
+{
+    auto now = std::chrono::steady_clock::now();
+
+    if (pVoiceReconnectRequested.exchange(false) && !pReconnectingVoice) {
+        {
+            std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+            pVoiceReconnectState
+                = audio::captureRadioState(*pClient, shared::fetchedStations);
+        }
+        pReconnectingVoice = true;
+        pVoiceReconnectAttempts = 0;
+        // afv_native may come back on its own, give it the first delay
+        pVoiceReconnectNextAttempt = now + kVoiceReconnectBaseDelay;
+
+        spdlog::warn("Voice session lost, snapshot of {} stations taken",
+            pVoiceReconnectState.size());
+    }
+
+    if (!pReconnectingVoice) {
+        return;
+    }
+
+    if (pClient->IsVoiceConnected()) {
+        // Frequencies the client lost are added back, the queue skips the
+        // switches that survived, and all of it goes out as one batch
+        {
+            std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+            submitRadioState(pVoiceReconnectState);
+        }
+
+        spdlog::info("Voice reconnected after {} attempts, restored {} "
+                     "stations",
+            pVoiceReconnectAttempts, pVoiceReconnectState.size());
+        pReconnectingVoice = false;
+        pVoiceReconnectState.clear();
+        return;
+    }
+
+    if (now < pVoiceReconnectNextAttempt) {
+        return;
+    }
+
+    if (pVoiceReconnectAttempts >= kVoiceReconnectMaxAttempts) {
+        spdlog::error("Giving up on the voice server after {} attempts",
+            pVoiceReconnectAttempts);
+        errorModal("Lost the connection to the voice server and could not "
+                   "reconnect, please check the log file.");
+        disconnectAndCleanup();
+        playErrorSound();
+        return;
+    }
+
+    pVoiceReconnectAttempts++;
+    auto delay = std::min(
+        kVoiceReconnectBaseDelay * (1 << pVoiceReconnectAttempts),
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            kVoiceReconnectMaxDelay));
+    pVoiceReconnectNextAttempt = now + delay;
+
+    spdlog::info("Voice reconnect attempt {}, next one in {}ms",
+        pVoiceReconnectAttempts, delay.count());
+
+    // The API session may still be half up, start from a clean one. Position,
+    // credentials and callsign are kept by the client.
+    if (pClient->IsAPIConnected()) {
+        pClient->Disconnect();
+    }
+    if (!pClient->Connect()) {
+        spdlog::warn("Voice reconnect attempt {} could not start",
+            pVoiceReconnectAttempts);
+    }
+}
+
 void App::disconnectAndCleanup()
 {
     if (!pClient) {
         return;
     }
 
+    // Nothing queued may add a frequency back once they are removed
+    if (pRadioCommands) {
+        pRadioCommands->clear();
+    }
+
+    // The voice server drop this causes is not a lost session to reconnect
+    if (pClient->IsVoiceConnected()) {
+        pManuallyDisconnected = true;
+    }
     pClient->Disconnect();
     pClient->StopAudio();
 
@@ -989,6 +1672,16 @@ void App::disconnectAndCleanup()
 
     shared::fetchedStations.clear();
     shared::bootUpVccs = false;
+    pActiveProfile.clear();
+    if (pPtt) {
+        pPtt->reset();
+    }
+    pAwaitingVoiceReconnect = false;
+    pRecoveringAudio = false;
+    pReconnectingVoice = false;
+    pVoiceReconnectRequested = false;
+    pVoiceReconnectState.clear();
+    pDisconnectRequested = false;
 }
 
 void App::playErrorSound()
@@ -1032,10 +1725,10 @@ void App::addNewStation(std::string stationCallsign)
                 pClient->SetClientPosition(latitude, longitude,
                     shared::defaultSUPTransceiverPositionElevation,
                     shared::defaultSUPTransceiverPositionElevation);
-                pClient->AddFrequency(
-                    shared::kUnicomFrequency, stationCallsign);
-                pClient->SetRx(shared::kUnicomFrequency, true);
-                pClient->SetRadioGainAll(shared::radioGain / 100.0F);
+                audio::RadioSwitches switches;
+                switches.rx = true;
+                submitRadioCommand(shared::kUnicomFrequency, stationCallsign,
+                    switches, false);
 
             } else {
                 errorModal("Could not find pilot connected under that "
@@ -1050,12 +1743,14 @@ void App::addNewStation(std::string stationCallsign)
         double longitude = 0.0;
         stationCallsign = stationCallsign.substr(1);
 
-        int frequency = 0;
-        try {
-            frequency = std::stoi(stationCallsign) * 1000;
-        } catch (...) {
+        // #132830 or #132.830, a channel name
+        auto parsedFrequency = channels::parseName(stationCallsign);
+        if (!parsedFrequency
+            || !channels::isValidKHz(*parsedFrequency / 1000)) {
             errorModal("Failed to parse frequency, format is #123456");
+            return;
         }
+        int frequency = *parsedFrequency;
 
         std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
 
@@ -1068,9 +1763,9 @@ void App::addNewStation(std::string stationCallsign)
             pClient->SetClientPosition(latitude, longitude,
                 shared::defaultSUPTransceiverPositionElevation,
                 shared::defaultSUPTransceiverPositionElevation);
-            pClient->AddFrequency(frequency, "MANUAL");
-            pClient->SetRx(frequency, true);
-            pClient->SetRadioGainAll(shared::radioGain / 100.0F);
+            audio::RadioSwitches switches;
+            switches.rx = true;
+            submitRadioCommand(frequency, "MANUAL", switches, false);
         } else {
             errorModal("The same frequency is already active, please "
                        "delete it first.");
@@ -0,0 +1,119 @@
+#include "audio/device_registry.h"
+
+#include "perf/trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace vector_audio::audio {
+
+DeviceRegistry::DeviceRegistry(
+    std::shared_ptr<afv_native::api::atcClient> client, unsigned int audioApi)
+    : pClient(std::move(client))
+    , pAudioApi(audioApi)
+{
+    pWorker = std::thread(&DeviceRegistry::worker, this);
+    SDL_AddEventWatch(&DeviceRegistry::onSdlEvent, this);
+}
+
+DeviceRegistry::~DeviceRegistry()
+{
+    SDL_DelEventWatch(&DeviceRegistry::onSdlEvent, this);
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pRunning = false;
+    }
+    pCv.notify_all();
+    if (pWorker.joinable()) {
+        pWorker.join();
+    }
+}
+
+void DeviceRegistry::refresh(unsigned int audioApi)
+{
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pAudioApi = audioApi;
+        pRefreshPending = true;
+    }
+    pCv.notify_one();
+}
+
+void DeviceRegistry::refresh()
+{
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pRefreshPending = true;
+    }
+    pCv.notify_one();
+}
+
+std::shared_ptr<const DeviceSnapshot> DeviceRegistry::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+    return pSnapshot;
+}
+
+void DeviceRegistry::worker()
+{
+    perf::trace::setThreadName("audio_devices");
+
+    std::chrono::milliseconds retryDelay = kRetryBaseDelay;
+    std::unique_lock<std::mutex> lock(pMutex);
+    while (true) {
+        pCv.wait(lock, [this]() { return !pRunning || pRefreshPending; });
+        if (!pRunning) {
+            return;
+        }
+        pRefreshPending = false;
+        auto audioApi = pAudioApi;
+        lock.unlock();
+
+        auto begin = std::chrono::steady_clock::now();
+        auto next = std::make_shared<DeviceSnapshot>();
+        next->audioApi = audioApi;
+        try {
+            next->audioApis = pClient->GetAudioApis();
+            next->inputDevices = pClient->GetAudioInputDevices(audioApi);
+            next->outputDevices = pClient->GetAudioOutputDevices(audioApi);
+        } catch (std::exception& ex) {
+            spdlog::error("Could not enumerate audio devices, retrying in "
+                          "{}ms: {}",
+                retryDelay.count(), ex.what());
+            lock.lock();
+            if (!pCv.wait_for(lock, retryDelay,
+                    [this]() { return !pRunning || pRefreshPending; })) {
+                pRefreshPending = true;
+            }
+            retryDelay = std::min(retryDelay * 2,
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    kRetryMaxDelay));
+            continue;
+        }
+        retryDelay = kRetryBaseDelay;
+        auto end = std::chrono::steady_clock::now();
+        if (perf::trace::enabled()) {
+            perf::trace::complete("audio_device_enumeration", begin, end);
+        }
+        spdlog::debug("Enumerated {} input and {} output devices in {}ms",
+            next->inputDevices.size(), next->outputDevices.size(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(end - begin)
+                .count());
+
+        lock.lock();
+        next->generation = ++pGeneration;
+        pSnapshot = std::move(next);
+    }
+}
+
+int DeviceRegistry::onSdlEvent(void* userdata, SDL_Event* event)
+{
+    if (event->type == SDL_AUDIODEVICEADDED
+        || event->type == SDL_AUDIODEVICEREMOVED) {
+        static_cast<DeviceRegistry*>(userdata)->refresh();
+    }
+    return 0;
+}
+}
@@ -0,0 +1,243 @@
+#include "audio/radio_commands.h"
+
+#include "perf/instrumentation.h"
+#include "perf/trace.h"
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace vector_audio::audio {
+
+void RadioSwitches::merge(const RadioSwitches& newer)
+{
+    rx = newer.rx ? newer.rx : rx;
+    tx = newer.tx ? newer.tx : tx;
+    xc = newer.xc ? newer.xc : xc;
+    onHeadset = newer.onHeadset ? newer.onHeadset : onHeadset;
+}
+
+RadioCommandQueue::RadioCommandQueue(
+    std::shared_ptr<afv_native::api::atcClient> client, float radioGain,
+    AppliedHandler onApplied)
+    : pClient(std::move(client))
+    , pOnApplied(std::move(onApplied))
+    , pRadioGain(radioGain)
+{
+    pWorker = std::thread(&RadioCommandQueue::worker, this);
+}
+
+RadioCommandQueue::~RadioCommandQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pRunning = false;
+    }
+    pCv.notify_all();
+    if (pWorker.joinable()) {
+        pWorker.join();
+    }
+}
+
+uint64_t RadioCommandQueue::submit(RadioCommand command)
+{
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        queue(std::move(command));
+        version = ++pSubmittedVersion;
+    }
+    pCv.notify_one();
+    return version;
+}
+
+uint64_t RadioCommandQueue::submit(std::vector<RadioCommand> commands)
+{
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        for (auto& command : commands) {
+            queue(std::move(command));
+        }
+        version = ++pSubmittedVersion;
+    }
+    pCv.notify_one();
+    return version;
+}
+
+uint64_t RadioCommandQueue::setRadioGain(float gain)
+{
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        pRadioGain = gain;
+        pRadioGainChanged = true;
+        version = ++pSubmittedVersion;
+    }
+    pCv.notify_one();
+    return version;
+}
+
+bool RadioCommandQueue::waitApplied(
+    uint64_t version, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(pMutex);
+    return pIdleCv.wait_for(
+        lock, timeout, [&]() { return pAppliedVersion >= version; });
+}
+
+void RadioCommandQueue::queue(RadioCommand command)
+{
+    auto it = pQueued.find(command.frequencyHz);
+    if (it == pQueued.end() || command.remove) {
+        // A removal replaces what was queued
+        pQueued.insert_or_assign(command.frequencyHz, std::move(command));
+    } else if (it->second.remove) {
+        // A command after a removal still removes first, then adds the
+        // frequency back from scratch
+        command.resetFirst = true;
+        it->second = std::move(command);
+    } else {
+        auto& queued = it->second;
+        queued.switches.merge(command.switches);
+        queued.inputFilter = command.inputFilter;
+        queued.outputEffects = command.outputEffects;
+    }
+}
+
+std::optional<RadioSwitches> RadioCommandQueue::pending(int frequencyHz) const
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+
+    std::optional<RadioSwitches> switches;
+    for (const auto* commands : { &pApplyingCommands, &pQueued }) {
+        auto it = commands->find(frequencyHz);
+        if (it == commands->end()) {
+            continue;
+        }
+        if (it->second.remove) {
+            switches = RadioSwitches { false, false, false, std::nullopt };
+            continue;
+        }
+        if (it->second.resetFirst) {
+            switches = RadioSwitches { false, false, false, std::nullopt };
+        } else if (!switches) {
+            switches = RadioSwitches {};
+        }
+        switches->merge(it->second.switches);
+    }
+    return switches;
+}
+
+void RadioCommandQueue::clear()
+{
+    std::unique_lock<std::mutex> lock(pMutex);
+    pQueued.clear();
+    pRadioGainChanged = false;
+    pIdleCv.wait(lock, [this]() { return !pApplying; });
+
+    // Dropped versions count as done, nobody should wait on them
+    pAppliedVersion = pSubmittedVersion;
+    pIdleCv.notify_all();
+}
+
+void RadioCommandQueue::worker()
+{
+    perf::trace::setThreadName("radio_commands");
+
+    std::unique_lock<std::mutex> lock(pMutex);
+    while (true) {
+        pCv.wait(lock, [this]() {
+            return !pRunning || !pQueued.empty() || pRadioGainChanged;
+        });
+        pCv.wait_for(lock, kBatchWindow, [this]() { return !pRunning; });
+        if (!pRunning) {
+            return;
+        }
+
+        pApplyingCommands.swap(pQueued);
+        auto version = pSubmittedVersion;
+        auto radioGain = pRadioGain;
+        auto radioGainChanged = std::exchange(pRadioGainChanged, false);
+        pApplying = true;
+        lock.unlock();
+
+        try {
+            apply(pApplyingCommands, radioGain, radioGainChanged);
+        } catch (std::exception& ex) {
+            spdlog::error("Could not apply radio commands: {}", ex.what());
+        }
+
+        lock.lock();
+        pApplyingCommands.clear();
+        pApplying = false;
+        pAppliedVersion = std::max(pAppliedVersion, version);
+        pIdleCv.notify_all();
+
+        if (pOnApplied) {
+            lock.unlock();
+            pOnApplied();
+            lock.lock();
+        }
+    }
+}
+
+void RadioCommandQueue::apply(const std::map<int, RadioCommand>& batch,
+    float radioGain, bool radioGainChanged)
+{
+    perf::ScopedTimer timer(perf::Metric::kRadioCommandBatch);
+
+    const RadioCommand* lastAdded = nullptr;
+    for (const auto& [frequencyHz, command] : batch) {
+        auto frequency = static_cast<unsigned int>(frequencyHz);
+
+        if (command.remove || command.resetFirst) {
+            if (pClient->IsFrequencyActive(frequency)) {
+                pClient->RemoveFrequency(frequency);
+            }
+        }
+        if (command.remove) {
+            continue;
+        }
+
+        const auto& switches = command.switches;
+        if (!pClient->IsFrequencyActive(frequency)) {
+            // Turning things off on a frequency that is gone already
+            if (!switches.rx.value_or(false) && !switches.tx.value_or(false)
+                && !switches.xc.value_or(false)) {
+                continue;
+            }
+            pClient->AddFrequency(frequency, command.callsign);
+            if (command.useStationTransceivers) {
+                pClient->UseTransceiversFromStation(
+                    command.callsign, frequencyHz);
+            }
+            lastAdded = &command;
+        }
+
+        if (switches.tx && pClient->GetTxState(frequency) != *switches.tx) {
+            pClient->SetTx(frequency, *switches.tx);
+        }
+        if (switches.rx && pClient->GetRxState(frequency) != *switches.rx) {
+            pClient->SetRx(frequency, *switches.rx);
+        }
+        if (switches.xc && pClient->GetXcState(frequency) != *switches.xc) {
+            pClient->SetXc(frequency, *switches.xc);
+        }
+        if (switches.onHeadset
+            && pClient->GetOnHeadset(frequency) != *switches.onHeadset) {
+            pClient->SetOnHeadset(frequency, *switches.onHeadset);
+        }
+    }
+
+    // New frequencies pick the effects and the gain up from the client wide
+    // settings, so these only have to be set once per batch
+    if (lastAdded != nullptr) {
+        pClient->SetEnableInputFilters(lastAdded->inputFilter);
+        pClient->SetEnableOutputEffects(lastAdded->outputEffects);
+    }
+    if (lastAdded != nullptr || radioGainChanged) {
+        pClient->SetRadioGainAll(radioGain);
+    }
+}
+}
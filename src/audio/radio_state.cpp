@@ -0,0 +1,29 @@
+#include "audio/radio_state.h"
+
+#include <utility>
+
+namespace vector_audio::audio {
+
+std::vector<StationState> captureRadioState(
+    afv_native::api::atcClient& client, const std::vector<ns::Station>& stations)
+{
+    std::vector<StationState> states;
+    states.reserve(stations.size());
+    for (const auto& station : stations) {
+        auto freq = static_cast<unsigned int>(station.getFrequencyHz());
+        if (!client.IsFrequencyActive(freq)) {
+            continue;
+        }
+
+        StationState state;
+        state.callsign = station.getCallsign();
+        state.frequencyHz = station.getFrequencyHz();
+        state.rx = client.GetRxState(freq);
+        state.tx = client.GetTxState(freq);
+        state.xc = client.GetXcState(freq);
+        state.onHeadset = client.GetOnHeadset(freq);
+        states.push_back(std::move(state));
+    }
+    return states;
+}
+}
@@ -0,0 +1,144 @@
+#include "audio/rx_history.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vector_audio::audio {
+
+namespace {
+    int64_t toUnixMs(std::chrono::system_clock::time_point at)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            at.time_since_epoch())
+            .count();
+    }
+
+    // The callsign is stored as words so the slot only holds atomics
+    using CallsignWords
+        = std::array<uint64_t, RxHistory::kCallsignSize / sizeof(uint64_t)>;
+
+    CallsignWords packCallsign(std::string_view callsign)
+    {
+        std::array<char, RxHistory::kCallsignSize> bytes {};
+        std::memcpy(bytes.data(), callsign.data(),
+            std::min(callsign.size(), bytes.size() - 1));
+
+        CallsignWords words {};
+        std::memcpy(words.data(), bytes.data(), bytes.size());
+        return words;
+    }
+}
+
+void RxHistory::begin(std::string_view callsign, int frequencyHz,
+    std::chrono::system_clock::time_point at)
+{
+    uint64_t id = pLatestId.load(std::memory_order_relaxed) + 1;
+    Slot& slot = pSlots[(id - 1) % kCapacity];
+    auto words = packCallsign(callsign);
+
+    uint64_t version = slot.version.load(std::memory_order_relaxed);
+    slot.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.id.store(id, std::memory_order_relaxed);
+    for (size_t i = 0; i < words.size(); i++) {
+        slot.callsign[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.frequencyHz.store(frequencyHz, std::memory_order_relaxed);
+    slot.startMs.store(toUnixMs(at), std::memory_order_relaxed);
+    slot.durationMs.store(-1, std::memory_order_relaxed);
+
+    slot.version.store(version + 2, std::memory_order_release);
+    pLatestId.store(id, std::memory_order_release);
+}
+
+void RxHistory::end(std::string_view callsign, int frequencyHz,
+    std::chrono::system_clock::time_point at)
+{
+    // Only this thread writes, so the slots can be read without the seqlock
+    auto words = packCallsign(callsign);
+    uint64_t latest = pLatestId.load(std::memory_order_relaxed);
+    uint64_t oldest = latest > kCapacity ? latest - kCapacity + 1 : 1;
+
+    for (uint64_t id = latest; id >= oldest && id > 0; id--) {
+        Slot& slot = pSlots[(id - 1) % kCapacity];
+        if (slot.durationMs.load(std::memory_order_relaxed) >= 0
+            || slot.frequencyHz.load(std::memory_order_relaxed) != frequencyHz) {
+            continue;
+        }
+
+        bool sameCallsign = true;
+        for (size_t i = 0; i < words.size(); i++) {
+            sameCallsign = sameCallsign
+                && slot.callsign[i].load(std::memory_order_relaxed) == words[i];
+        }
+        if (!sameCallsign) {
+            continue;
+        }
+
+        int64_t duration = std::max<int64_t>(
+            0, toUnixMs(at) - slot.startMs.load(std::memory_order_relaxed));
+
+        uint64_t version = slot.version.load(std::memory_order_relaxed);
+        slot.version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.durationMs.store(duration, std::memory_order_relaxed);
+        slot.version.store(version + 2, std::memory_order_release);
+        return;
+    }
+}
+
+uint64_t RxHistory::latestId() const
+{
+    return pLatestId.load(std::memory_order_acquire);
+}
+
+void RxHistory::copySince(uint64_t sinceId, std::vector<Entry>& out) const
+{
+    uint64_t latest = pLatestId.load(std::memory_order_acquire);
+    uint64_t first = std::max(
+        sinceId + 1, latest > kCapacity ? latest - kCapacity + 1 : 1);
+
+    Entry entry;
+    for (uint64_t id = first; id <= latest; id++) {
+        if (readSlot(pSlots[(id - 1) % kCapacity], id, entry)) {
+            out.push_back(entry);
+        }
+    }
+}
+
+bool RxHistory::readSlot(const Slot& slot, uint64_t id, Entry& out) const
+{
+    for (int attempt = 0; attempt < kReadAttempts; attempt++) {
+        uint64_t before = slot.version.load(std::memory_order_acquire);
+        if ((before & 1U) != 0) {
+            continue;
+        }
+
+        out.id = slot.id.load(std::memory_order_relaxed);
+        CallsignWords words {};
+        for (size_t i = 0; i < words.size(); i++) {
+            words[i] = slot.callsign[i].load(std::memory_order_relaxed);
+        }
+        out.frequencyHz = slot.frequencyHz.load(std::memory_order_relaxed);
+        out.startMs = slot.startMs.load(std::memory_order_relaxed);
+        out.durationMs = slot.durationMs.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+
+        // Overwritten by a newer transmission since the id was read
+        if (out.id != id) {
+            return false;
+        }
+
+        std::memcpy(out.callsign.data(), words.data(), out.callsign.size());
+        out.callsign.back() = '\0';
+        return true;
+    }
+
+    return false;
+}
+}
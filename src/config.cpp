@@ -1,7 +1,9 @@
 #include "config.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <filesystem>
+#include <fstream>
 
 #ifdef SFML_SYSTEM_MACOS
 #include "native/osx_resources.h"
@@ -88,14 +90,92 @@ std::string Configuration::get_linux_config_folder()
 
 void Configuration::write_config_async()
 {
-    std::thread([]() {
-        const std::lock_guard<std::mutex> lock(
-            vector_audio::Configuration::mConfigWriterLock);
-        std::ofstream ofs(Configuration::get_config_folder_path()
-            / std::filesystem::path(mConfigFileName));
-        ofs << vector_audio::Configuration::mConfig;
-        ofs.close();
-    }).detach();
+    {
+        const std::lock_guard<std::mutex> lock(mConfigWriterLock);
+        auto now = std::chrono::steady_clock::now();
+        if (!mPendingConfig) {
+            mFirstPendingChange = now;
+        }
+        mLastPendingChange = now;
+        mPendingConfig = mConfig;
+
+        if (!mConfigWriterThread) {
+            mConfigWriterRunning = true;
+            mConfigWriterThread
+                = std::make_unique<std::thread>(&config_writer_worker);
+        }
+    }
+    mConfigWriterCv.notify_one();
+}
+
+void Configuration::flush_config()
+{
+    {
+        const std::lock_guard<std::mutex> lock(mConfigWriterLock);
+        mConfigWriterRunning = false;
+    }
+    mConfigWriterCv.notify_one();
+
+    if (mConfigWriterThread && mConfigWriterThread->joinable()) {
+        mConfigWriterThread->join();
+    }
+    mConfigWriterThread.reset();
+}
+
+void Configuration::config_writer_worker()
+{
+    std::unique_lock<std::mutex> lk(mConfigWriterLock);
+    while (true) {
+        mConfigWriterCv.wait(
+            lk, [] { return mPendingConfig || !mConfigWriterRunning; });
+
+        if (!mPendingConfig) {
+            return; // Shutting down with nothing left to write
+        }
+
+        // Debounce, each new change pushes the write back up to a limit
+        while (mConfigWriterRunning) {
+            auto deadline = std::min(mLastPendingChange + kWriteDebounce,
+                mFirstPendingChange + kWriteMaxDelay);
+            if (std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            mConfigWriterCv.wait_until(lk, deadline);
+        }
+
+        toml::value snapshot = std::move(*mPendingConfig);
+        mPendingConfig.reset();
+
+        lk.unlock();
+        write_config_file(snapshot);
+        lk.lock();
+    }
+}
+
+void Configuration::write_config_file(const toml::value& config)
+{
+    // Write to a temporary file first so that a crash mid-write can never
+    // leave a truncated config behind
+    const auto configFilePath
+        = get_config_folder_path() / std::filesystem::path(mConfigFileName);
+    auto tempFilePath = configFilePath;
+    tempFilePath += ".tmp";
+
+    try {
+        {
+            std::ofstream ofs(tempFilePath, std::ios::trunc);
+            ofs << config;
+            ofs.close();
+            if (!ofs) {
+                spdlog::error("Could not write config file {}",
+                    tempFilePath.string());
+                return;
+            }
+        }
+        std::filesystem::rename(tempFilePath, configFilePath);
+    } catch (const std::exception& ex) {
+        spdlog::error("Could not save config file: {}", ex.what());
+    }
 }
 
 void Configuration::build_logger()
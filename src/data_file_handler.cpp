@@ -8,69 +8,74 @@ vector_audio::vatsim::DataHandler::DataHandler()
 }
 
 std::string vector_audio::vatsim::DataHandler::downloadString(
-    httplib::Client& cli, std::string url)
+    httplib::Client& cli, std::string url, bool* failed)
 {
+    perf::ScopedTimer timer(perf::Metric::kDatafileDownload);
+    if (failed != nullptr) {
+        *failed = true;
+    }
+
     auto res = cli.Get(url);
     if (!res) {
         spdlog::error("Could not download URL: {}", url);
+        perf::increment(perf::Counter::kDatafilePollFailures);
         return "";
     }
 
     if (res->status != 200) {
         spdlog::error("Couldn't load {}, HTTP error {}", url, res->status);
+        perf::increment(perf::Counter::kDatafilePollFailures);
         return "";
     }
 
+    if (failed != nullptr) {
+        *failed = false;
+    }
     return res->body;
 }
 
 bool vector_audio::vatsim::DataHandler::parseSlurper(
     const std::string& sluper_data)
 {
+    perf::ScopedTimer timer(perf::Metric::kDatafileParse);
     if (sluper_data.empty()) {
         return false;
     }
 
-    auto lines = absl::StrSplit(sluper_data, '\n');
-    std::string callsign;
-    std::string res3;
-    std::string res2;
-    std::string lat;
-    std::string lon;
+    std::string_view callsign;
+    std::string_view type;
+    std::string_view frequency;
+    std::string_view lat;
+    std::string_view lon;
     bool foundNotAtisConnection = false;
 
-    for (const auto& line : lines) {
-        if (line.empty()) {
-            continue;
-        }
-
-        std::vector<std::string> res = absl::StrSplit(line, ',');
-
-        if (absl::EndsWith(res[1], "_ATIS")) {
-            continue; // Ignore ATIS connections
-        }
+    slurper::forEachConnection(
+        sluper_data, [&](const slurper::Connection& connection) {
+            if (absl::EndsWith(connection.callsign, "_ATIS")) {
+                return true; // Ignore ATIS connections
+            }
 
-        foundNotAtisConnection = true;
+            foundNotAtisConnection = true;
 
-        auto allowedYx = { "_CTR", "_APP", "_TWR", "_GND", "_DEL", "_FSS",
-            "_SUP", "_RDO", "_RMP", "_TMU", "_FMP" };
+            auto allowedYx = { "_CTR", "_APP", "_TWR", "_GND", "_DEL", "_FSS",
+                "_SUP", "_RDO", "_RMP", "_TMU", "_FMP" };
 
-        for (const auto& yxTest : allowedYx) {
-            if (absl::EndsWith(res[1], yxTest)) {
-                pYx = true;
-                break;
+            for (const auto& yxTest : allowedYx) {
+                if (absl::EndsWith(connection.callsign, yxTest)) {
+                    pYx = true;
+                    break;
+                }
             }
-        }
 
-        callsign = res[1];
-        res3 = res[3];
-        res2 = res[2];
+            callsign = connection.callsign;
+            type = connection.type;
+            frequency = connection.frequency;
 
-        lat = res[5];
-        lon = res[6];
+            lat = connection.latitude;
+            lon = connection.longitude;
 
-        break;
-    }
+            return false;
+        });
 
     if (callsign == "DCLIENT3") {
         return false;
@@ -80,15 +85,20 @@ bool vector_audio::vatsim::DataHandler::parseSlurper(
         return false;
     }
 
-    res3.erase(std::remove(res3.begin(), res3.end(), '.'), res3.end());
-    int u334 = std::atoi(res3.c_str()) * 1000;
+    int u334 = 0;
+    slurper::parseFrequencyHz(frequency, u334);
 
-    int k422 = std::stoi(res2, nullptr, 16) == 10 && pYx ? 1 : 0;
+    int k422 = slurper::parseTypeCode(type).value_or(0) == 10 && pYx ? 1 : 0;
 
     k422 = u334 != shared::kObsFrequency && k422 == 1   ? 1
         : k422 == 1 && absl::EndsWith(callsign, "_SUP") ? 1
                                                         : 0;
 
+    double latitude = 0.0;
+    double longitude = 0.0;
+    slurper::parseCoordinate(lat, latitude);
+    slurper::parseCoordinate(lon, longitude);
+
     if (shared::session::isConnected && shared::session::callsign != callsign) {
         spdlog::warn(
             "Detected an active session but with a different callsign");
@@ -96,9 +106,8 @@ bool vector_audio::vatsim::DataHandler::parseSlurper(
                       // disconnect
     }
 
-    vector_audio::vatsim::DataHandler::updateSessionInfo(callsign,
-        util::cleanUpFrequency(u334), k422, std::atof(lat.c_str()),
-        std::atof(lon.c_str()));
+    vector_audio::vatsim::DataHandler::updateSessionInfo(std::string(callsign),
+        util::cleanUpFrequency(u334), k422, latitude, longitude);
 
     return true;
 }
@@ -200,6 +209,7 @@ void vector_audio::vatsim::DataHandler::handleDisconnect()
 
 bool vector_audio::vatsim::DataHandler::parseDatafile(const std::string& data)
 {
+    perf::ScopedTimer timer(perf::Metric::kDatafileParse);
     try {
         if (!nlohmann::json::accept(data)) {
             spdlog::error("Failed to parse datafile: not valid JSON");
@@ -220,13 +230,11 @@ bool vector_audio::vatsim::DataHandler::parseDatafile(const std::string& data)
                                   // active session, we disconnect
                 }
 
-                auto res3 = controller["frequency"].get<std::string>();
-                res3.erase(
-                    std::remove(res3.begin(), res3.end(), '.'), res3.end());
-                int u334 = std::atoi(res3.c_str()) * 1000;
+                auto u334 = channels::parseName(
+                    controller["frequency"].get<std::string>());
 
                 vector_audio::vatsim::DataHandler::updateSessionInfo(callsign,
-                    util::cleanUpFrequency(u334),
+                    util::cleanUpFrequency(u334.value_or(0)),
                     controller["facility"].get<int>());
 
                 return true;
@@ -263,32 +271,128 @@ void vector_audio::vatsim::DataHandler::handleConnect()
 
 void vector_audio::vatsim::DataHandler::worker()
 {
+    perf::trace::setThreadName("datafile_worker");
+
     {
         const std::lock_guard<std::mutex> l(shared::session::m);
         this->getAvailableEndpoints();
     }
 
     std::unique_lock<std::mutex> lk(pDfMutex);
+    std::chrono::milliseconds delay;
     do {
-        if (!this->isSlurperAvailable() || !this->isDatafileAvailable()) {
-            this->getAvailableEndpoints();
+        if (pPollRequested) {
+            pPollRequested = false;
+            pScheduler.expedite(PollScheduler::Clock::now());
         }
+        lk.unlock();
+
+        {
+            perf::ScopedTimer timer(perf::Metric::kDatafilePoll);
+            perf::increment(perf::Counter::kDatafilePolls);
 
-        auto res = false;
+            if (!this->isSlurperAvailable() || !this->isDatafileAvailable()) {
+                this->getAvailableEndpoints();
+            }
+
+            auto res = false;
+            // Stays set if neither endpoint is available
+            pLastPollFailed = true;
+
+            if (this->isSlurperAvailable()) {
+                res = this->getConnectionStatusWithSlurper();
+            } else if (this->isDatafileAvailable()) {
+                res = this->getConnectionStatusWithDatafile();
+            }
 
-        if (this->isSlurperAvailable()) {
-            res = this->getConnectionStatusWithSlurper();
-        } else if (this->isDatafileAvailable()) {
-            res = this->getConnectionStatusWithDatafile();
+            bool pushGrace = false;
+            bool pushedConnected = false;
+            {
+                const std::lock_guard<std::mutex> l(shared::session::m);
+                pushGrace = pLastPushAt
+                    && std::chrono::steady_clock::now() - *pLastPushAt
+                        < kPushGracePeriod;
+                pushedConnected = pPushedConnected;
+            }
+
+            if (pushGrace && res != pushedConnected) {
+                // The endpoints have not caught up with the pushed state yet
+                if (!pushedConnected) {
+                    const std::lock_guard<std::mutex> l(shared::session::m);
+                    resetSessionData();
+                }
+            } else if (!res) {
+                handleDisconnect();
+            } else {
+                handleConnect();
+            }
+
+            auto outcome = pLastPollFailed
+                ? PollScheduler::Outcome::kEndpointFailure
+                : (res ? PollScheduler::Outcome::kConnected
+                       : PollScheduler::Outcome::kNotConnected);
+            delay = pScheduler.next(
+                outcome, pHadOneDisconnect, PollScheduler::Clock::now());
+            if (outcome == PollScheduler::Outcome::kEndpointFailure) {
+                spdlog::warn("VATSIM endpoints unreachable, next poll in {}s",
+                    std::chrono::duration_cast<std::chrono::seconds>(delay)
+                        .count());
+            }
         }
 
-        if (!res) {
-            handleDisconnect();
-        } else {
-            handleConnect();
+        lk.lock();
+    } while (!pCv.wait_for(lk, delay,
+                 [this] { return !pKeepRunning || pPollRequested; })
+        || pKeepRunning);
+}
+
+void vector_audio::vatsim::DataHandler::pushSessionConnected(
+    const std::string& callsign, int frequencyHz, int facility,
+    double latitude, double longitude)
+{
+    if (frequencyHz == shared::kObsFrequency
+        && !absl::EndsWith(callsign, "_SUP")) {
+        facility = 0;
+    }
+
+    {
+        const std::lock_guard<std::mutex> l(shared::session::m);
+        if (shared::session::isConnected
+            && shared::session::callsign != callsign) {
+            spdlog::info("Pushed session changed callsign from {} to {}",
+                shared::session::callsign, callsign);
+            resetSessionData();
         }
+        pLastPushAt = std::chrono::steady_clock::now();
+        pPushedConnected = true;
+        pHadOneDisconnect = false;
+    }
+
+    updateSessionInfo(callsign, util::cleanUpFrequency(frequencyHz), facility,
+        latitude, longitude);
+    handleConnect();
+}
+
+void vector_audio::vatsim::DataHandler::pushSessionDisconnected()
+{
+    const std::lock_guard<std::mutex> l(shared::session::m);
+    pLastPushAt = std::chrono::steady_clock::now();
+    pPushedConnected = false;
+    pHadOneDisconnect = false;
 
-    } while (!pCv.wait_for(lk, 15s, [this] { return !pKeepRunning; }));
+    if (shared::session::isConnected) {
+        spdlog::info("VATSIM client disconnection pushed by plugin");
+        resetSessionData();
+    }
+}
+
+void vector_audio::vatsim::DataHandler::requestPoll()
+{
+    {
+        std::lock_guard<std::mutex> lk(pDfMutex);
+        pPollRequested = true;
+    }
+    pCv.notify_one();
 }
 
 bool vector_audio::vatsim::DataHandler::getConnectionStatusWithSlurper()
@@ -298,18 +402,21 @@ bool vector_audio::vatsim::DataHandler::getConnectionStatusWithSlurper()
     }
 
     if (shared::vatsimCid == 0) {
+        pLastPollFailed = false;
         return false;
     }
 
     auto cli = httplib::Client(slurper_host);
     std::string res;
+    bool failed = false;
     {
         const std::lock_guard<std::mutex> l(shared::session::m);
         std::string urlWithParams
             = std::string(slurper_url) + std::to_string(shared::vatsimCid);
         res = vector_audio::vatsim::DataHandler::downloadString(
-            cli, urlWithParams);
+            cli, urlWithParams, &failed);
     }
+    pLastPollFailed = failed;
 
     return this->parseSlurper(res);
 }
@@ -321,8 +428,10 @@ bool vector_audio::vatsim::DataHandler::getConnectionStatusWithDatafile()
     }
 
     auto cli = httplib::Client(this->pDatafileHost);
+    bool failed = false;
     std::string res = vector_audio::vatsim::DataHandler::downloadString(
-        cli, this->pDatafileUrl);
+        cli, this->pDatafileUrl, &failed);
+    pLastPollFailed = failed;
 
     return this->parseDatafile(res);
 }
@@ -343,26 +452,28 @@ bool vector_audio::vatsim::DataHandler::getPilotPositionWithSlurper(
         return false;
     }
 
-    try {
-        auto lines = absl::StrSplit(res, '\n');
-        for (const auto& line : lines) {
-            std::vector<std::string> splits = absl::StrSplit(line, ',');
-            if (splits.size() < 7) {
-                continue;
-            }
-
-            if (splits[2] == "pilot") {
-                latitude = std::stod(splits[5]);
-                longitude = std::stod(splits[6]);
+    bool found = false;
+    slurper::forEachConnection(res, [&](const slurper::Connection& connection) {
+        if (connection.type != "pilot") {
+            return true;
+        }
 
-                return true;
-            }
+        double lat = 0.0;
+        double lon = 0.0;
+        if (!slurper::parseCoordinate(connection.latitude, lat)
+            || !slurper::parseCoordinate(connection.longitude, lon)) {
+            spdlog::error("Error parsing pilot slurper position: {},{}",
+                connection.latitude, connection.longitude);
+            return false;
         }
-    } catch (const std::exception& e) {
-        spdlog::error("Error parsing pilot slurper position: %s", e.what());
-    }
 
-    return false;
+        latitude = lat;
+        longitude = lon;
+        found = true;
+        return false;
+    });
+
+    return found;
 }
 
 bool vector_audio::vatsim::DataHandler::getPilotPositionWithDatafile(
@@ -0,0 +1,359 @@
+#include "input/evdev_ptt.h"
+
+#include "keyboardUtil.h"
+#include "perf/trace.h"
+
+#include <spdlog/spdlog.h>
+
+#ifdef __linux__
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <vector>
+#endif
+
+namespace vector_audio::input {
+
+#ifdef __linux__
+namespace {
+    constexpr const char* kInputDirectory = "/dev/input";
+
+    constexpr size_t kKeyBitsSize = KEY_MAX / CHAR_BIT + 1;
+    using key_bits_t = std::array<uint8_t, kKeyBitsSize>;
+
+    bool testBit(const key_bits_t& bits, int bit)
+    {
+        return (bits[static_cast<size_t>(bit) / CHAR_BIT]
+                   >> (static_cast<size_t>(bit) % CHAR_BIT))
+            & 1U;
+    }
+
+    // Keyboards only, mice and joysticks report buttons above the key range
+    bool hasKeys(int fd)
+    {
+        key_bits_t bits {};
+        if (ioctl(fd, EVIOCGBIT(EV_KEY, bits.size()), bits.data()) < 0) {
+            return false;
+        }
+        for (int key = KEY_ESC; key < BTN_MISC; key++) {
+            if (testBit(bits, key)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool isEventDevice(const char* name)
+    {
+        return std::strncmp(name, "event", 5) == 0;
+    }
+
+    // An eventfd write only fails when its counter would overflow
+    void wake(int fd)
+    {
+        uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(fd, &one, sizeof(one));
+    }
+}
+#endif
+
+EvdevPtt::EvdevPtt(PttController& ptt)
+    : pPtt(ptt)
+{
+}
+
+EvdevPtt::~EvdevPtt()
+{
+#ifdef __linux__
+    pStopping = true;
+    if (pWakeFd >= 0) {
+        wake(pWakeFd);
+    }
+    if (pThread.joinable()) {
+        pThread.join();
+    }
+
+    while (!pDevices.empty()) {
+        closeDevice(pDevices.begin()->first);
+    }
+    if (pInotifyFd >= 0) {
+        close(pInotifyFd);
+    }
+    if (pWakeFd >= 0) {
+        close(pWakeFd);
+    }
+#endif
+}
+
+bool EvdevPtt::isSupported()
+{
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool EvdevPtt::setKey(sf::Keyboard::Scancode key)
+{
+#ifdef __linux__
+    if (key == pScancode) {
+        return pKeyReadable;
+    }
+    pScancode = key;
+
+    int code = KeyboardUtil::convertFromSFMLToEvdev(key);
+    pKeyReadable = code != KEY_RESERVED || key == sf::Keyboard::Scan::Unknown;
+    if (!pKeyReadable) {
+        spdlog::warn("The PTT key {} has no evdev code, it is polled instead",
+            static_cast<int>(key));
+    }
+    if (pKey.exchange(code) != code && pWakeFd >= 0) {
+        wake(pWakeFd);
+    }
+    return pKeyReadable;
+#else
+    return false;
+#endif
+}
+
+bool EvdevPtt::start()
+{
+#ifdef __linux__
+    pWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    pInotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (pWakeFd < 0 || pInotifyFd < 0) {
+        spdlog::error(
+            "Could not set up the evdev PTT: {}", std::strerror(errno));
+        return false;
+    }
+
+    // udev fixes the permissions of a new node after creating it
+    if (inotify_add_watch(pInotifyFd, kInputDirectory, IN_CREATE | IN_ATTRIB)
+        < 0) {
+        spdlog::warn("Input devices plugged in later are not watched: {}",
+            std::strerror(errno));
+    }
+
+    if (DIR* directory = opendir(kInputDirectory)) {
+        while (const dirent* entry = readdir(directory)) {
+            if (isEventDevice(entry->d_name)) {
+                openDevice(std::string(kInputDirectory) + "/" + entry->d_name);
+            }
+        }
+        closedir(directory);
+    }
+
+    if (pDevices.empty()) {
+        spdlog::warn("No keyboard could be read from {}, is the user in the "
+                     "input group? The PTT key is polled instead",
+            kInputDirectory);
+        return false;
+    }
+
+    pThread = std::thread([this]() {
+        perf::trace::setThreadName("ptt_evdev");
+        run();
+    });
+    spdlog::info("Reading the PTT key from {} keyboards", pDevices.size());
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef __linux__
+void EvdevPtt::run()
+{
+    std::vector<pollfd> fds;
+    while (!pStopping) {
+        applyKey();
+
+        fds.clear();
+        fds.push_back({ pWakeFd, POLLIN, 0 });
+        fds.push_back({ pInotifyFd, POLLIN, 0 });
+        for (const auto& [fd, device] : pDevices) {
+            fds.push_back({ fd, POLLIN, 0 });
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            spdlog::error("evdev PTT stopped: {}", std::strerror(errno));
+            return;
+        }
+
+        if ((fds[0].revents & POLLIN) != 0) {
+            uint64_t count = 0;
+            [[maybe_unused]] auto drained
+                = ::read(pWakeFd, &count, sizeof(count));
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            readInotify();
+        }
+        for (size_t i = 2; i < fds.size(); i++) {
+            if ((fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+                closeDevice(fds[i].fd);
+            } else if ((fds[i].revents & POLLIN) != 0) {
+                readDevice(fds[i].fd);
+            }
+        }
+    }
+}
+
+bool EvdevPtt::openDevice(const std::string& path)
+{
+    for (const auto& [fd, device] : pDevices) {
+        if (device.path == path) {
+            return true;
+        }
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    if (!hasKeys(fd)) {
+        close(fd);
+        return false;
+    }
+
+    Device device;
+    device.path = path;
+    int clock = CLOCK_MONOTONIC;
+    device.monotonic = ioctl(fd, EVIOCSCLOCKID, &clock) == 0;
+    pDevices.emplace(fd, std::move(device));
+
+    std::array<char, 256> name {};
+    if (ioctl(fd, EVIOCGNAME(name.size() - 1), name.data()) < 0) {
+        name[0] = '\0';
+    }
+    spdlog::debug("evdev PTT reads {} ({})", path, name.data());
+    return true;
+}
+
+void EvdevPtt::closeDevice(int fd)
+{
+    setPressed(fd, false, perf::Clock::now());
+    close(fd);
+    pDevices.erase(fd);
+}
+
+void EvdevPtt::readDevice(int fd)
+{
+    std::array<input_event, 64> events {};
+    for (;;) {
+        auto size = ::read(fd, events.data(), sizeof(events));
+        if (size < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                // ENODEV once the device is unplugged
+                closeDevice(fd);
+            }
+            return;
+        }
+
+        bool dropped = false;
+        auto count = static_cast<size_t>(size) / sizeof(input_event);
+        for (size_t i = 0; i < count; i++) {
+            const auto& event = events[i];
+            if (event.type == EV_SYN && event.code == SYN_DROPPED) {
+                dropped = true;
+                continue;
+            }
+            // Auto repeat is value 2, only edges matter
+            if (event.type != EV_KEY || event.code != pActiveKey
+                || event.value > 1) {
+                continue;
+            }
+
+            auto at = perf::Clock::now();
+            if (pDevices[fd].monotonic) {
+                at = perf::Clock::time_point(
+                    std::chrono::duration_cast<perf::Clock::duration>(
+                        std::chrono::seconds(event.input_event_sec)
+                        + std::chrono::microseconds(event.input_event_usec)));
+            }
+            setPressed(fd, event.value == 1, at);
+        }
+
+        // The kernel queue overflowed, ask for the key as it is now
+        if (dropped) {
+            key_bits_t bits {};
+            if (ioctl(fd, EVIOCGKEY(bits.size()), bits.data()) >= 0) {
+                setPressed(fd, testBit(bits, pActiveKey), perf::Clock::now());
+            }
+        }
+        if (static_cast<size_t>(size) < sizeof(events)) {
+            return;
+        }
+    }
+}
+
+void EvdevPtt::readInotify()
+{
+    alignas(inotify_event) std::array<char, 4096> buffer {};
+    for (;;) {
+        auto size = ::read(pInotifyFd, buffer.data(), buffer.size());
+        if (size <= 0) {
+            return;
+        }
+        for (ssize_t offset = 0; offset < size;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(
+                buffer.data() + offset);
+            if (event->len > 0 && isEventDevice(event->name)) {
+                auto path = std::string(kInputDirectory) + "/" + event->name;
+                if (openDevice(path)) {
+                    spdlog::info("evdev PTT picked up {}", path);
+                }
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+}
+
+void EvdevPtt::applyKey()
+{
+    int key = pKey;
+    if (key == pActiveKey) {
+        return;
+    }
+    pActiveKey = key;
+
+    // Whatever held the previous key does not hold the new one
+    if (!pPressed.empty()) {
+        pPressed.clear();
+        pPtt.setLocal(PttController::LocalSource::kKeyboard, false,
+            perf::Clock::now());
+    }
+}
+
+void EvdevPtt::setPressed(int fd, bool pressed, perf::Clock::time_point at)
+{
+    bool wasPressed = !pPressed.empty();
+    if (pressed && pActiveKey != KEY_RESERVED) {
+        pPressed.insert(fd);
+    } else {
+        pPressed.erase(fd);
+    }
+
+    // Several keyboards may hold the key, only the first press and the last
+    // release are edges
+    if (wasPressed != !pPressed.empty()) {
+        pPtt.setLocal(
+            PttController::LocalSource::kKeyboard, !pPressed.empty(), at);
+    }
+}
+#endif
+}
@@ -0,0 +1,229 @@
+#include "input/joystick_ptt.h"
+
+#include "channels.h"
+#include "shared.h"
+
+#include <SDL_error.h>
+#include <array>
+#include <iterator>
+#include <optional>
+#include <spdlog/spdlog.h>
+
+namespace vector_audio::input {
+
+namespace {
+    std::string guidOf(SDL_Joystick* joystick)
+    {
+        if (joystick == nullptr) {
+            return {};
+        }
+        std::array<char, 33> guid {};
+        SDL_JoystickGetGUIDString(SDL_JoystickGetGUID(joystick), guid.data(),
+            static_cast<int>(guid.size()));
+        return guid.data();
+    }
+
+    std::optional<JoystickBinding> loadBinding(const toml::value& entry)
+    {
+        JoystickBinding binding;
+        binding.guid = toml::find_or<std::string>(entry, "device", "");
+        binding.deviceName = toml::find_or<std::string>(entry, "name", "");
+        binding.button = toml::find_or<int>(entry, "button", -1);
+        if (binding.button < 0) {
+            return std::nullopt;
+        }
+
+        auto frequency = toml::find_or<std::string>(entry, "frequency", "");
+        if (!frequency.empty()) {
+            auto frequencyHz = channels::parseName(frequency);
+            if (!frequencyHz) {
+                return std::nullopt;
+            }
+            binding.frequencyHz = *frequencyHz;
+        }
+        return binding;
+    }
+}
+
+std::vector<JoystickBinding> loadJoystickBindings(const toml::value& config)
+{
+    std::vector<JoystickBinding> bindings;
+    if (!config.is_table()) {
+        return bindings;
+    }
+
+    if (!config.contains("joystick_ptt")) {
+        // Instance ids change between runs, only the button is kept
+        auto button = toml::find_or<int>(config, "user", "joyStickPtt", -1);
+        if (button >= 0) {
+            JoystickBinding binding;
+            binding.button = button;
+            bindings.push_back(std::move(binding));
+        }
+        return bindings;
+    }
+
+    if (!config.at("joystick_ptt").is_array()) {
+        return bindings;
+    }
+    for (const auto& entry : config.at("joystick_ptt").as_array()) {
+        if (auto binding = loadBinding(entry)) {
+            bindings.push_back(std::move(*binding));
+        } else {
+            spdlog::warn("Skipped a malformed joystick PTT binding");
+        }
+    }
+    return bindings;
+}
+
+void storeJoystickBindings(
+    toml::value& config, const std::vector<JoystickBinding>& bindings)
+{
+    toml::value list = toml::array {};
+    for (const auto& binding : bindings) {
+        toml::value entry = toml::table {};
+        entry["device"] = binding.guid;
+        entry["name"] = binding.deviceName;
+        entry["button"] = binding.button;
+        if (binding.frequencyHz != 0) {
+            entry["frequency"] = channels::formatName(binding.frequencyHz);
+        }
+        list.push_back(std::move(entry));
+    }
+    config["joystick_ptt"] = std::move(list);
+}
+
+JoystickPtt::JoystickPtt(PttController& ptt)
+    : pPtt(ptt)
+{
+}
+
+JoystickPtt::~JoystickPtt()
+{
+    for (auto [instanceId, joystick] : pDevices) {
+        SDL_JoystickClose(joystick);
+    }
+}
+
+void JoystickPtt::handleEvent(const SDL_Event& event)
+{
+    switch (event.type) {
+    case SDL_JOYDEVICEADDED:
+        open(event.jdevice.which);
+        break;
+    case SDL_JOYDEVICEREMOVED:
+        close(event.jdevice.which);
+        break;
+    case SDL_JOYBUTTONDOWN:
+        press(event.jbutton.which, event.jbutton.button);
+        break;
+    case SDL_JOYBUTTONUP:
+        release(event.jbutton.which, event.jbutton.button);
+        break;
+    default:
+        break;
+    }
+}
+
+JoystickBinding JoystickPtt::describe(
+    SDL_JoystickID instanceId, int button, int frequencyHz)
+{
+    SDL_Joystick* joystick = SDL_JoystickFromInstanceID(instanceId);
+
+    JoystickBinding binding;
+    binding.guid = guidOf(joystick);
+    const char* name = joystick ? SDL_JoystickName(joystick) : nullptr;
+    binding.deviceName = name ? name : "";
+    binding.button = button;
+    binding.frequencyHz = frequencyHz;
+    return binding;
+}
+
+void JoystickPtt::open(int deviceIndex)
+{
+    SDL_Joystick* joystick = SDL_JoystickOpen(deviceIndex);
+    if (joystick == nullptr) {
+        spdlog::warn("Could not open joystick {}: {}", deviceIndex,
+            SDL_GetError());
+        return;
+    }
+
+    auto instanceId = SDL_JoystickInstanceID(joystick);
+    if (!pDevices.emplace(instanceId, joystick).second) {
+        SDL_JoystickClose(joystick);
+        return;
+    }
+    const char* name = SDL_JoystickName(joystick);
+    spdlog::info("Joystick connected: {} ({})", name ? name : "Unknown",
+        guidOf(joystick));
+}
+
+void JoystickPtt::close(SDL_JoystickID instanceId)
+{
+    for (auto it = pHeld.begin(); it != pHeld.end();) {
+        auto next = std::next(it);
+        if (it->first.first == instanceId) {
+            release(instanceId, it->first.second);
+        }
+        it = next;
+    }
+
+    auto it = pDevices.find(instanceId);
+    if (it == pDevices.end()) {
+        return;
+    }
+    SDL_JoystickClose(it->second);
+    pDevices.erase(it);
+    spdlog::info("Joystick disconnected: {}", instanceId);
+}
+
+void JoystickPtt::press(SDL_JoystickID instanceId, int button)
+{
+    auto key = std::make_pair(instanceId, button);
+    if (pHeld.count(key) > 0) {
+        return;
+    }
+
+    auto guid = guidOf(SDL_JoystickFromInstanceID(instanceId));
+    std::vector<int> frequencies;
+    for (const auto& binding : shared::joystickBindings) {
+        if (binding.button == button
+            && (binding.guid.empty() || binding.guid == guid)) {
+            frequencies.push_back(binding.frequencyHz);
+        }
+    }
+    if (frequencies.empty()) {
+        return;
+    }
+
+    auto observedAt = perf::Clock::now();
+    for (auto frequencyHz : frequencies) {
+        if (frequencyHz != 0) {
+            pPtt.setFrequencyKey(frequencyHz, true, observedAt);
+        } else if (pGeneralHeld++ == 0) {
+            pPtt.setLocal(PttController::LocalSource::kJoystick, true,
+                observedAt);
+        }
+    }
+    pHeld.emplace(key, std::move(frequencies));
+}
+
+void JoystickPtt::release(SDL_JoystickID instanceId, int button)
+{
+    auto it = pHeld.find(std::make_pair(instanceId, button));
+    if (it == pHeld.end()) {
+        return;
+    }
+
+    auto observedAt = perf::Clock::now();
+    for (auto frequencyHz : it->second) {
+        if (frequencyHz != 0) {
+            pPtt.setFrequencyKey(frequencyHz, false, observedAt);
+        } else if (--pGeneralHeld == 0) {
+            pPtt.setLocal(PttController::LocalSource::kJoystick, false,
+                observedAt);
+        }
+    }
+    pHeld.erase(it);
+}
+}
@@ -0,0 +1,209 @@
+#include "input/ptt_controller.h"
+
+#include "perf/counters.h"
+#include "perf/trace.h"
+#include "shared.h"
+
+#include <spdlog/spdlog.h>
+#include <utility>
+#include <vector>
+
+namespace vector_audio::input {
+
+PttController::PttController(
+    std::shared_ptr<afv_native::api::atcClient> client,
+    TxChangedHandler onTxChanged)
+    : pClient(std::move(client))
+    , pOnTxChanged(std::move(onTxChanged))
+{
+}
+
+void PttController::setLocal(
+    LocalSource source, bool pressed, perf::Clock::time_point observedAt)
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+    auto bit = static_cast<uint8_t>(source);
+    pLocalSources = static_cast<uint8_t>(
+        pressed ? pLocalSources | bit : pLocalSources & ~bit);
+    update(perf::Metric::kPttEdge, observedAt);
+}
+
+void PttController::expire(perf::Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+    bool released = false;
+    for (auto it = pSenders.begin(); it != pSenders.end();) {
+        if (now - it->second.lastSeen < kSenderTimeout) {
+            ++it;
+            continue;
+        }
+        if (it->second.pressed) {
+            spdlog::warn("PTT sender {} went quiet while pressed, released",
+                it->first);
+            released = true;
+        }
+        it = pSenders.erase(it);
+    }
+
+    if (released) {
+        update(perf::Metric::kPttExternal, now);
+    }
+}
+
+void PttController::setFrequencyKey(
+    int frequencyHz, bool pressed, perf::Clock::time_point observedAt)
+{
+    auto frequency = static_cast<unsigned int>(frequencyHz);
+
+    // Read before pMutex, the TX changed handler takes the station mutex
+    // too and is never called with pMutex held
+    std::vector<unsigned int> stations;
+    if (pressed) {
+        if (shared::session::facility <= 0
+            || !pClient->IsFrequencyActive(frequency)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+        stations.reserve(shared::fetchedStations.size());
+        for (const auto& el : shared::fetchedStations) {
+            stations.push_back(static_cast<unsigned int>(el.getFrequencyHz()));
+        }
+    }
+
+    bool txChanged = false;
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        if (pressed) {
+            // Stations added since the first key keep their own switch
+            for (auto station : stations) {
+                if (pClient->IsFrequencyActive(station)) {
+                    pSavedTx.try_emplace(
+                        station, pClient->GetTxState(station));
+                }
+            }
+            pKeyedFrequencies[frequency]++;
+
+            // TX first, so that nothing goes out on the other frequencies
+            txChanged = applyKeyedTx();
+            update(perf::Metric::kPttEdge, observedAt);
+        } else {
+            auto it = pKeyedFrequencies.find(frequency);
+            if (it == pKeyedFrequencies.end()) {
+                return;
+            }
+            if (--it->second == 0) {
+                pKeyedFrequencies.erase(it);
+            }
+
+            // PTT first, unless something else holds it
+            update(perf::Metric::kPttEdge, observedAt);
+            txChanged = applyKeyedTx();
+            if (pKeyedFrequencies.empty()) {
+                pSavedTx.clear();
+            }
+        }
+    }
+
+    if (txChanged && pOnTxChanged) {
+        pOnTxChanged();
+    }
+}
+
+bool PttController::handle(uint64_t sender, const PttCommand& command,
+    perf::Clock::time_point receivedAt)
+{
+    {
+        std::lock_guard<std::mutex> lock(pMutex);
+        auto [it, inserted] = pSenders.try_emplace(sender);
+        auto& state = it->second;
+        if (!inserted && receivedAt - state.lastSeen < kSenderTimeout
+            && static_cast<int32_t>(command.sequence - state.sequence) <= 0) {
+            perf::increment(perf::Counter::kPttStaleCommands);
+            return false;
+        }
+        state.sequence = command.sequence;
+        state.lastSeen = receivedAt;
+
+        if (command.kind == PttCommand::Kind::kPtt) {
+            state.pressed = command.on;
+            update(perf::Metric::kPttExternal, receivedAt);
+            return true;
+        }
+    }
+
+    // TX is set straight away rather than through the radio command queue,
+    // the websocket clients hear about it once it is done
+    auto frequency = static_cast<unsigned int>(command.frequencyHz);
+    if (shared::session::facility <= 0
+        || !pClient->IsFrequencyActive(frequency)) {
+        return false;
+    }
+    if (pClient->GetTxState(frequency) != command.on) {
+        pClient->SetTx(frequency, command.on);
+        if (pOnTxChanged) {
+            pOnTxChanged();
+        }
+    }
+    return true;
+}
+
+void PttController::release(uint64_t sender)
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+    auto it = pSenders.find(sender);
+    if (it == pSenders.end()) {
+        return;
+    }
+    bool pressed = it->second.pressed;
+    pSenders.erase(it);
+
+    if (pressed) {
+        update(perf::Metric::kPttExternal, perf::Clock::now());
+    }
+}
+
+void PttController::reset()
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+    pLocalSources = 0;
+    pSenders.clear();
+    pKeyedFrequencies.clear();
+    pSavedTx.clear();
+    update(perf::Metric::kPttEdge, perf::Clock::now());
+}
+
+bool PttController::isOpen() const { return pOpen; }
+
+void PttController::update(
+    perf::Metric metric, perf::Clock::time_point observedAt)
+{
+    bool open = pLocalSources != 0 || !pKeyedFrequencies.empty();
+    for (const auto& [id, sender] : pSenders) {
+        open = open || sender.pressed;
+    }
+    if (open == pOpen) {
+        return;
+    }
+
+    pOpen = open;
+    pClient->SetPtt(open);
+    perf::record(metric, perf::Clock::now() - observedAt);
+    perf::trace::instant(open ? "ptt_open" : "ptt_close");
+}
+
+bool PttController::applyKeyedTx()
+{
+    bool changed = false;
+    for (const auto& [frequency, saved] : pSavedTx) {
+        bool tx = pKeyedFrequencies.empty()
+            ? saved
+            : pKeyedFrequencies.count(frequency) > 0;
+        if (pClient->IsFrequencyActive(frequency)
+            && pClient->GetTxState(frequency) != tx) {
+            pClient->SetTx(frequency, tx);
+            changed = true;
+        }
+    }
+    return changed;
+}
+}
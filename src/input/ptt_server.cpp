@@ -0,0 +1,74 @@
+#include "input/ptt_server.h"
+
+#include "perf/trace.h"
+
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace vector_audio::input {
+
+namespace asio = restinio::asio_ns;
+
+PttServer::PttServer(uint16_t port, Handler handler)
+    : pPort(port)
+    , pHandler(std::move(handler))
+    , pSocket(pIo)
+{
+}
+
+PttServer::~PttServer()
+{
+    pIo.stop();
+    if (pThread.joinable()) {
+        pThread.join();
+    }
+}
+
+bool PttServer::start()
+{
+    try {
+        // Loopback only, panels are driven by a local bridge or plugin
+        pSocket.open(asio::ip::udp::v4());
+        pSocket.bind(
+            asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), pPort));
+    } catch (const std::exception& ex) {
+        spdlog::error("Could not open the PTT port {}: {}", pPort, ex.what());
+        return false;
+    }
+
+    receive();
+    pThread = std::thread([this]() {
+        perf::trace::setThreadName("ptt_input");
+        pIo.run();
+    });
+    spdlog::info("Listening for PTT datagrams on 127.0.0.1:{}", pPort);
+    return true;
+}
+
+void PttServer::receive()
+{
+    pSocket.async_receive_from(asio::buffer(pBuffer), pSenderEndpoint,
+        [this](const asio::error_code& ec, size_t size) {
+            auto receivedAt = perf::Clock::now();
+            if (ec == asio::error::operation_aborted) {
+                return;
+            }
+
+            if (!ec) {
+                if (auto command = decodePttPacket(pBuffer.data(), size)) {
+                    uint64_t sender
+                        = static_cast<uint64_t>(
+                              pSenderEndpoint.address().to_v4().to_uint())
+                            << 16U
+                        | pSenderEndpoint.port();
+                    pHandler(sender, *command, receivedAt);
+                } else {
+                    spdlog::debug("Dropped a malformed PTT datagram of {} "
+                                  "bytes",
+                        size);
+                }
+            }
+            receive();
+        });
+}
+}
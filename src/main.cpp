@@ -7,6 +7,10 @@
 #include "keyboardUtil.h"
 #include "native/single_instance.h"
 #include "native/window_manager.h"
+#include "perf/allocations.h"
+#include "perf/counters.h"
+#include "perf/instrumentation.h"
+#include "perf/startup.h"
 #include "shared.h"
 #include "spdlog/spdlog.h"
 #include "ui/style.h"
@@ -26,10 +30,12 @@
 #include <SFML/Window/Keyboard.hpp>
 #include <string>
 #include <thread>
+#include <utility>
 
 // Main code
 int main(int, char**)
 {
+    vector_audio::perf::startup::markProcessStart();
 
     std::srand(static_cast<unsigned int>(time(nullptr)));
 
@@ -40,12 +46,71 @@ int main(int, char**)
 
     vector_audio::Configuration::build_logger();
 
+#ifdef SFML_SYSTEM_WINDOWS
+    std::string iconPath
+        = (vector_audio::Configuration::get_resource_folder() / std::filesystem::path("icon_win.png")).string();
+#else
+    std::string iconPath
+        = (vector_audio::Configuration::get_resource_folder() / std::filesystem::path("icon_mac.png")).string();
+#endif
+
+    SDL_Surface* icon = nullptr;
+    std::unique_ptr<vector_audio::application::App> currentApp;
+
+    // Stages that do not need the window or ImGui run on workers while the
+    // main thread sets those up. Declared after everything the stages write
+    // to, so an early return waits for them before those are destroyed.
+    vector_audio::perf::startup::Pipeline startup;
+
+    startup.add("config", []() {
+        vector_audio::Configuration::build_config();
+
+        if (toml::find_or<bool>(vector_audio::Configuration::mConfig, "debug",
+                "trace", false)) {
+            spdlog::info("Trace recording enabled");
+            vector_audio::perf::trace::start();
+        }
+    });
+
+    startup.add("icon", [&icon, &iconPath]() {
+        icon = IMG_Load(iconPath.c_str());
+        if (icon == nullptr) {
+            spdlog::warn("Failed to load app icon: {}", IMG_GetError());
+        }
+    });
+
+    startup.add("disconnect_sound", []() {
+        auto soundPath = vector_audio::Configuration::get_resource_folder()
+            / std::filesystem::path("disconnect.wav");
+
+        if (std::filesystem::exists(soundPath)) {
+            auto* ret = SDL_LoadWAV(soundPath.string().c_str(),
+                &vector_audio::shared::pDisconnectSoundWavSpec,
+                &vector_audio::shared::pDisconnectSoundWavBuffer,
+                &vector_audio::shared::pDisconnectSoundWavLength);
+            if (ret == nullptr) {
+                disconnectWarningSoundAvailable = false;
+                spdlog::error(
+                    "Could not load disconnect sound file: {}", SDL_GetError());
+            }
+        } else {
+            disconnectWarningSoundAvailable = false;
+            spdlog::warn("Disconnect sound file not found: {}",
+                soundPath.string().c_str());
+        }
+    });
+
     SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS, "1");
 
     // Setup SDL
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_GAMECONTROLLER
-            | SDL_INIT_AUDIO | SDL_INIT_EVENTS | SDL_INIT_JOYSTICK)
-        != 0) {
+    bool sdlReady = false;
+    startup.runHere("sdl_init", [&sdlReady]() {
+        sdlReady = SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER
+                       | SDL_INIT_GAMECONTROLLER | SDL_INIT_AUDIO
+                       | SDL_INIT_EVENTS | SDL_INIT_JOYSTICK)
+            == 0;
+    });
+    if (!sdlReady) {
         printf("Error: %s\n", SDL_GetError());
         return -1;
     }
@@ -55,6 +120,7 @@ int main(int, char**)
 #endif
 
     // Create window with SDL_Renderer graphics context
+    auto windowBegin = vector_audio::perf::startup::Clock::now();
     auto windowFlags = static_cast<SDL_WindowFlags>(
         SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
     SDL_Window* window = SDL_CreateWindow("VectorAudio", SDL_WINDOWPOS_CENTERED,
@@ -70,42 +136,19 @@ int main(int, char**)
         SDL_Log("Error creating SDL_Renderer!");
         return 0;
     }
+    vector_audio::perf::startup::record(
+        "window", windowBegin, vector_audio::perf::startup::Clock::now());
 
-#ifdef SFML_SYSTEM_WINDOWS
-    std::string iconPath
-        = (vector_audio::Configuration::get_resource_folder() / std::filesystem::path("icon_win.png")).string();
-#else
-    std::string iconPath
-        = (vector_audio::Configuration::get_resource_folder() / std::filesystem::path("icon_mac.png")).string();
-#endif
-
-    SDL_Surface* icon = IMG_Load(iconPath.c_str());
-    if (icon != NULL) {
+    startup.wait("icon");
+    if (icon != nullptr) {
         SDL_SetWindowIcon(window, icon);
-    } else {
-        spdlog::warn("Failed to load app icon: {}", IMG_GetError());
-    }
-
-    auto soundPath = vector_audio::Configuration::get_resource_folder()
-        / std::filesystem::path("disconnect.wav");
-
-    if (std::filesystem::exists(soundPath)) {
-        auto* ret = SDL_LoadWAV(soundPath.string().c_str(),
-            &vector_audio::shared::pDisconnectSoundWavSpec,
-            &vector_audio::shared::pDisconnectSoundWavBuffer,
-            &vector_audio::shared::pDisconnectSoundWavLength);
-        if (ret == nullptr) {
-            disconnectWarningSoundAvailable = false;
-            spdlog::error(
-                "Could not load disconnect sound file: {}", SDL_GetError());
-        }
-    } else {
-        disconnectWarningSoundAvailable = false;
-        spdlog::warn("Disconnect sound file not found: {}", soundPath.string().c_str());
     }
 
     // Setup Dear ImGui context
+    auto imguiBegin = vector_audio::perf::startup::Clock::now();
     IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(vector_audio::perf::allocations::imguiAlloc,
+        vector_audio::perf::allocations::imguiFree);
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     (void)io;
@@ -127,15 +170,34 @@ int main(int, char**)
     }
 
     vector_audio::style::apply_style();
-    vector_audio::Configuration::build_config();
+    vector_audio::perf::startup::record(
+        "imgui_setup", imguiBegin, vector_audio::perf::startup::Clock::now());
 
     ImVec4 clearColor = ImVec4(0.45F, 0.55F, 0.60F, 1.00F);
 
     spdlog::info("Starting VectorAudio...");
 
-    auto updaterInstance = std::make_unique<vector_audio::Updater>();
-
-    auto currentApp = std::make_unique<vector_audio::application::App>();
+    // The app opens the disconnect sound device and starts afv_native, SDL
+    // audio is only safe on the thread that initialised it
+    startup.runHere(
+        "app",
+        [&currentApp]() {
+            currentApp = std::make_unique<vector_audio::application::App>();
+        },
+        { "config", "disconnect_sound" });
+
+    std::unique_ptr<vector_audio::Updater> updaterInstance;
+    startup.runHere("updater", [&updaterInstance]() {
+        updaterInstance = std::make_unique<vector_audio::Updater>();
+    });
+
+    startup.waitAll();
+    vector_audio::perf::trace::setThreadName("ui");
+
+    if (!currentApp) {
+        spdlog::critical("Could not create the application, exiting");
+        return -1;
+    }
 
     bool alwaysOnTop = vector_audio::shared::keepWindowOnTop;
 
@@ -144,6 +206,9 @@ int main(int, char**)
     // Main loop
     bool done = false;
     while (!done) {
+        vector_audio::perf::ScopedTimer frameTimer(
+            vector_audio::perf::Metric::kFrameTime);
+        auto frameAllocations = vector_audio::perf::allocations::thisThread();
 
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
@@ -168,33 +233,35 @@ int main(int, char**)
                                  "code");
                 }
 
-                vector_audio::shared::joyStickId = -1;
-                vector_audio::shared::joyStickPtt = -1;
-                vector_audio::Configuration::mConfig["user"]["joyStickId"]
-                    = vector_audio::shared::joyStickId;
-                vector_audio::Configuration::mConfig["user"]["joyStickPtt"]
-                    = vector_audio::shared::joyStickPtt;
                 vector_audio::Configuration::mConfig["user"]["ptt"]
                     = static_cast<int>(vector_audio::shared::ptt);
                 vector_audio::Configuration::write_config_async();
                 vector_audio::shared::capturePttFlag = false;
             }
 
+            // A captured button is not handed to the app, it would key PTT
             if (event.type == SDL_JOYBUTTONDOWN
-                && vector_audio::shared::capturePttFlag) {
-                vector_audio::shared::ptt = sf::Keyboard::Scancode::Unknown;
-
-                vector_audio::shared::joyStickId = event.jbutton.which;
-                vector_audio::shared::joyStickPtt = event.jbutton.button;
-
-                vector_audio::Configuration::mConfig["user"]["joyStickId"]
-                    = vector_audio::shared::joyStickId;
-                vector_audio::Configuration::mConfig["user"]["joyStickPtt"]
-                    = vector_audio::shared::joyStickPtt;
-                vector_audio::Configuration::mConfig["user"]["ptt"]
-                    = static_cast<int>(vector_audio::shared::ptt);
+                && (vector_audio::shared::capturePttFlag
+                    || vector_audio::shared::captureJoystickFlag)) {
+                auto binding = vector_audio::input::JoystickPtt::describe(
+                    event.jbutton.which, event.jbutton.button,
+                    vector_audio::shared::captureJoystickFlag
+                        ? vector_audio::shared::captureJoystickFrequencyHz
+                        : 0);
+                vector_audio::shared::joystickBindings.push_back(
+                    std::move(binding));
+
+                vector_audio::input::storeJoystickBindings(
+                    vector_audio::Configuration::mConfig,
+                    vector_audio::shared::joystickBindings);
                 vector_audio::Configuration::write_config_async();
                 vector_audio::shared::capturePttFlag = false;
+                vector_audio::shared::captureJoystickFlag = false;
+                continue;
+            }
+
+            if (currentApp) {
+                currentApp->handleInputEvent(event);
             }
         }
 
@@ -209,7 +276,9 @@ int main(int, char**)
         ImGui_ImplSDL2_NewFrame();
         ImGui::NewFrame();
 
-        if (!updaterInstance->need_update())
+        // The check may only finish during a session, the update is then
+        // asked for once it is over
+        if (!updaterInstance->need_update() || currentApp->isConnected())
             currentApp->render_frame();
         else
             updaterInstance->draw();
@@ -226,12 +295,31 @@ int main(int, char**)
         SDL_RenderClear(renderer);
         ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData());
         SDL_RenderPresent(renderer);
+
+        vector_audio::perf::set(
+            vector_audio::perf::Gauge::kFrameHeapAllocations,
+            static_cast<int64_t>(vector_audio::perf::allocations::thisThread()
+                - frameAllocations));
+
+        vector_audio::perf::startup::markFirstFrame();
     }
 
     if (currentApp) {
         currentApp.reset();
     }
 
+    vector_audio::Configuration::flush_config();
+
+    if (vector_audio::perf::trace::enabled()) {
+        auto tracePath = vector_audio::Configuration::get_config_folder_path()
+            / std::filesystem::path("vector_audio_trace.json");
+        if (vector_audio::perf::trace::writeTo(tracePath)) {
+            spdlog::info("Wrote trace to {}", tracePath.string());
+        } else {
+            spdlog::error("Could not write trace to {}", tracePath.string());
+        }
+    }
+
     // Cleanup
     ImGui_ImplSDLRenderer2_Shutdown();
     ImGui_ImplSDL2_Shutdown();
@@ -0,0 +1,53 @@
+#include "perf/allocations.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace vector_audio::perf::allocations {
+
+namespace {
+    // Trivial type, so it needs no dynamic initialisation and is usable from
+    // operator new on any thread
+    thread_local uint64_t tAllocations = 0;
+}
+
+uint64_t thisThread() { return tAllocations; }
+
+void* imguiAlloc(size_t size, void* /*userData*/)
+{
+    tAllocations++;
+    return std::malloc(size);
+}
+
+void imguiFree(void* ptr, void* /*userData*/) { std::free(ptr); }
+}
+
+// The array and nothrow forms forward to these by default. The aligned forms
+// are left alone, they are rare and keep their own matching delete.
+void* operator new(std::size_t size)
+{
+    vector_audio::perf::allocations::tAllocations++;
+
+    if (size == 0) {
+        size = 1;
+    }
+
+    while (true) {
+        if (void* ptr = std::malloc(size)) {
+            return ptr;
+        }
+
+        auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,85 @@
+#include "perf/counters.h"
+
+#include <array>
+#include <atomic>
+
+namespace vector_audio::perf {
+
+namespace {
+    constexpr size_t kCounterCount = static_cast<size_t>(Counter::kCount);
+    constexpr size_t kGaugeCount = static_cast<size_t>(Gauge::kCount);
+
+    constexpr std::array<const char*, kCounterCount> kCounterNames
+        = { "websocket_messages_sent", "websocket_bytes_sent",
+              "datafile_polls", "datafile_poll_failures", "voice_reconnects",
+              "ptt_stale_commands" };
+
+    constexpr std::array<const char*, kGaugeCount> kGaugeNames
+        = { "websocket_clients", "frame_heap_allocations" };
+
+    // Same order as afv_native::ClientEventType
+    constexpr std::array<const char*, kAfvEventTypeCount> kAfvEventNames
+        = { "APIServerConnected", "APIServerDisconnected", "APIServerError",
+              "VoiceServerConnected", "VoiceServerDisconnected",
+              "VoiceServerChannelError", "VoiceServerError", "PttOpen",
+              "PttClosed", "StationAliasesUpdated",
+              "StationTransceiversUpdated", "FrequencyRxBegin",
+              "FrequencyRxEnd", "StationRxBegin", "StationRxEnd", "AudioError",
+              "VccsReceived", "StationDataReceived", "InputDeviceError",
+              "AudioDisabled", "AudioDeviceStoppedError" };
+
+    std::array<std::atomic<uint64_t>, kCounterCount> counters {};
+    std::array<std::atomic<int64_t>, kGaugeCount> gauges {};
+    std::array<std::atomic<uint64_t>, kAfvEventTypeCount> afvEvents {};
+}
+
+void increment(Counter counter, uint64_t by)
+{
+    counters[static_cast<size_t>(counter)].fetch_add(
+        by, std::memory_order_relaxed);
+}
+
+uint64_t value(Counter counter)
+{
+    return counters[static_cast<size_t>(counter)].load(
+        std::memory_order_relaxed);
+}
+
+const char* counterName(Counter counter)
+{
+    return kCounterNames[static_cast<size_t>(counter)];
+}
+
+void set(Gauge gauge, int64_t v)
+{
+    gauges[static_cast<size_t>(gauge)].store(v, std::memory_order_relaxed);
+}
+
+int64_t value(Gauge gauge)
+{
+    return gauges[static_cast<size_t>(gauge)].load(std::memory_order_relaxed);
+}
+
+const char* gaugeName(Gauge gauge)
+{
+    return kGaugeNames[static_cast<size_t>(gauge)];
+}
+
+void countAfvEvent(afv_native::ClientEventType evt)
+{
+    auto index = static_cast<size_t>(evt);
+    if (index < kAfvEventTypeCount) {
+        afvEvents[index].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+uint64_t afvEventCount(size_t eventIndex)
+{
+    return afvEvents[eventIndex].load(std::memory_order_relaxed);
+}
+
+const char* afvEventName(size_t eventIndex)
+{
+    return kAfvEventNames[eventIndex];
+}
+}
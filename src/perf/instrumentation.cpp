@@ -0,0 +1,47 @@
+#include "perf/instrumentation.h"
+
+#include <spdlog/spdlog.h>
+
+namespace vector_audio::perf {
+
+namespace {
+    constexpr size_t kMetricCount = static_cast<size_t>(Metric::kCount);
+
+    constexpr std::array<const char*, kMetricCount> kMetricNames
+        = { "frame_time", "render_frame", "event_callback",
+              "datafile_download", "datafile_parse", "datafile_poll",
+              "sdk_handler", "websocket_broadcast", "ptt_edge",
+              "radio_command_batch", "ptt_external" };
+
+    std::array<Histogram, kMetricCount> histograms;
+}
+
+Histogram& histogram(Metric metric)
+{
+    return histograms[static_cast<size_t>(metric)];
+}
+
+const char* metricName(Metric metric)
+{
+    return kMetricNames[static_cast<size_t>(metric)];
+}
+
+void dumpToLog()
+{
+    spdlog::info("Performance summary (microseconds):");
+    for (size_t i = 0; i < kMetricCount; i++) {
+        auto s = histograms[i].snapshot();
+        spdlog::info("  {:<20} count={} mean={:.1f} p50={:.0f} p99={:.0f} "
+                     "max={:.1f}",
+            kMetricNames[i], s.count, s.meanUs(), s.percentileUs(0.50),
+            s.percentileUs(0.99), static_cast<double>(s.maxNs) / 1000.0);
+    }
+}
+
+void resetAll()
+{
+    for (auto& h : histograms) {
+        h.reset();
+    }
+}
+}
@@ -0,0 +1,69 @@
+#include "perf/openmetrics.h"
+
+#include "perf/counters.h"
+#include "perf/instrumentation.h"
+
+#include <fmt/format.h>
+#include <iterator>
+
+namespace vector_audio::perf {
+
+namespace {
+    constexpr const char* kPrefix = "vectoraudio_";
+
+    void appendHistogram(std::string& out, Metric metric)
+    {
+        auto s = histogram(metric).snapshot();
+        auto name = fmt::format("{}{}_seconds", kPrefix, metricName(metric));
+        auto it = std::back_inserter(out);
+
+        fmt::format_to(it, "# TYPE {} histogram\n", name);
+        uint64_t cumulative = 0;
+        // The last bucket is open ended and is covered by +Inf
+        for (size_t i = 0; i + 1 < Histogram::kBucketCount; i++) {
+            cumulative += s.buckets[i];
+            fmt::format_to(it, "{}_bucket{{le=\"{}\"}} {}\n", name,
+                Histogram::bucketUpperBoundUs(i) / 1e6, cumulative);
+        }
+        fmt::format_to(it, "{}_bucket{{le=\"+Inf\"}} {}\n", name, s.count);
+        fmt::format_to(it, "{}_sum {}\n", name,
+            static_cast<double>(s.sumNs) / 1e9);
+        fmt::format_to(it, "{}_count {}\n", name, s.count);
+    }
+}
+
+std::string renderOpenMetrics()
+{
+    std::string out;
+    out.reserve(16 * 1024);
+    auto it = std::back_inserter(out);
+
+    for (size_t i = 0; i < static_cast<size_t>(Metric::kCount); i++) {
+        appendHistogram(out, static_cast<Metric>(i));
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(Counter::kCount); i++) {
+        auto counter = static_cast<Counter>(i);
+        fmt::format_to(it, "# TYPE {}{} counter\n", kPrefix,
+            counterName(counter));
+        fmt::format_to(it, "{}{}_total {}\n", kPrefix, counterName(counter),
+            value(counter));
+    }
+
+    for (size_t i = 0; i < static_cast<size_t>(Gauge::kCount); i++) {
+        auto gauge = static_cast<Gauge>(i);
+        fmt::format_to(it, "# TYPE {}{} gauge\n", kPrefix, gaugeName(gauge));
+        fmt::format_to(
+            it, "{}{} {}\n", kPrefix, gaugeName(gauge), value(gauge));
+    }
+
+    fmt::format_to(it, "# TYPE {}afv_events counter\n", kPrefix);
+    for (size_t i = 0; i < kAfvEventTypeCount; i++) {
+        fmt::format_to(it, "{}afv_events_total{{type=\"{}\"}} {}\n", kPrefix,
+            afvEventName(i), afvEventCount(i));
+    }
+
+    out.append("# EOF\n");
+    return out;
+}
+}
@@ -0,0 +1,135 @@
+#include "perf/startup.h"
+
+#include "perf/trace.h"
+
+#include <atomic>
+#include <mutex>
+#include <spdlog/spdlog.h>
+#include <thread>
+
+namespace vector_audio::perf::startup {
+
+namespace {
+    Clock::time_point processStart = Clock::now();
+    std::thread::id mainThreadId = std::this_thread::get_id();
+
+    std::mutex stagesMutex;
+    std::vector<Stage> recordedStages;
+    std::atomic<int64_t> firstFrame = -1;
+
+    int64_t sinceStartUs(Clock::time_point t)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            t - processStart)
+            .count();
+    }
+
+    void runStage(const char* name, const std::function<void()>& task)
+    {
+        ScopedStage stage(name);
+        try {
+            task();
+        } catch (std::exception& ex) {
+            spdlog::error("Startup stage {} failed: {}", name, ex.what());
+        }
+    }
+}
+
+void markProcessStart()
+{
+    processStart = Clock::now();
+    mainThreadId = std::this_thread::get_id();
+}
+
+void record(const char* name, Clock::time_point begin, Clock::time_point end)
+{
+    {
+        std::lock_guard<std::mutex> lock(stagesMutex);
+        recordedStages.push_back({ name,
+            std::this_thread::get_id() == mainThreadId, sinceStartUs(begin),
+            std::chrono::duration_cast<std::chrono::microseconds>(end - begin)
+                .count() });
+    }
+    if (trace::enabled()) {
+        trace::complete(name, begin, end);
+    }
+}
+
+void markFirstFrame()
+{
+    int64_t expected = -1;
+    if (!firstFrame.compare_exchange_strong(
+            expected, sinceStartUs(Clock::now()))) {
+        return;
+    }
+
+    spdlog::info("First interactive frame after {:.1f}ms",
+        static_cast<double>(firstFrame.load()) / 1000.0);
+    for (const auto& stage : stages()) {
+        spdlog::info("  {:<20} {:>6} start {:>8.1f}ms took {:>8.1f}ms",
+            stage.name, stage.onMainThread ? "main" : "worker",
+            static_cast<double>(stage.beginUs) / 1000.0,
+            static_cast<double>(stage.durationUs) / 1000.0);
+    }
+}
+
+std::vector<Stage> stages()
+{
+    std::lock_guard<std::mutex> lock(stagesMutex);
+    return recordedStages;
+}
+
+int64_t firstFrameUs() { return firstFrame.load(); }
+
+Pipeline::~Pipeline() { waitAll(); }
+
+void Pipeline::add(const char* name, std::function<void()> task,
+    const std::vector<std::string>& dependsOn)
+{
+    std::vector<std::shared_future<void>> dependencies;
+    for (const auto& dependency : dependsOn) {
+        auto it = pStages.find(dependency);
+        if (it == pStages.end()) {
+            spdlog::error("Startup stage {} depends on unknown stage {}",
+                name, dependency);
+            continue;
+        }
+        dependencies.push_back(it->second);
+    }
+
+    pStages[name] = std::async(std::launch::async,
+        [name, task = std::move(task), dependencies = std::move(dependencies)]() {
+            trace::setThreadName("startup");
+            for (const auto& dependency : dependencies) {
+                dependency.wait();
+            }
+            runStage(name, task);
+        }).share();
+}
+
+void Pipeline::runHere(const char* name, const std::function<void()>& task,
+    const std::vector<std::string>& dependsOn)
+{
+    waitFor(dependsOn);
+    runStage(name, task);
+}
+
+void Pipeline::wait(const std::string& name) { waitFor({ name }); }
+
+void Pipeline::waitAll()
+{
+    for (const auto& [name, stage] : pStages) {
+        stage.wait();
+    }
+}
+
+void Pipeline::waitFor(const std::vector<std::string>& dependsOn)
+{
+    for (const auto& dependency : dependsOn) {
+        auto it = pStages.find(dependency);
+        if (it != pStages.end()) {
+            it->second.wait();
+        }
+    }
+}
+}
@@ -0,0 +1,181 @@
+#include "perf/trace.h"
+
+#include <array>
+#include <cstdint>
+#include <fmt/format.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vector_audio::perf::trace {
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // 16k events of 32 bytes, 512KiB per thread that ever emitted an event
+    constexpr size_t kEventsPerThread = 16 * 1024;
+
+    struct Event {
+        // Seqlock: odd while the owning thread is writing the slot
+        std::atomic<uint32_t> seq = 0;
+        char phase = 'X';
+        const char* name = nullptr;
+        int64_t beginNs = 0;
+        int64_t durationNs = 0;
+    };
+
+    struct ThreadBuffer {
+        uint32_t tid = 0;
+        std::atomic<const char*> threadName = nullptr;
+        std::atomic<uint64_t> written = 0;
+        std::array<Event, kEventsPerThread> events;
+    };
+
+    Clock::time_point traceStart;
+
+    // Buffers are never freed, detached threads may still hold a pointer
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    thread_local ThreadBuffer* localBuffer = nullptr;
+
+    ThreadBuffer* threadBuffer()
+    {
+        if (localBuffer == nullptr) {
+            auto buffer = std::make_unique<ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            buffer->tid = static_cast<uint32_t>(buffers.size() + 1);
+            localBuffer = buffer.get();
+            buffers.push_back(std::move(buffer));
+        }
+        return localBuffer;
+    }
+
+    int64_t sinceStart(Clock::time_point t)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            t - traceStart)
+            .count();
+    }
+
+    void append(char phase, const char* name, int64_t beginNs, int64_t durNs)
+    {
+        auto* buffer = threadBuffer();
+        auto n = buffer->written.load(std::memory_order_relaxed);
+        auto& ev = buffer->events[n % kEventsPerThread];
+
+        auto seq = ev.seq.load(std::memory_order_relaxed);
+        ev.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        ev.phase = phase;
+        ev.name = name;
+        ev.beginNs = beginNs;
+        ev.durationNs = durNs;
+        ev.seq.store(seq + 2, std::memory_order_release);
+
+        buffer->written.store(n + 1, std::memory_order_release);
+    }
+}
+
+void start()
+{
+    traceStart = Clock::now();
+    recording.store(true, std::memory_order_release);
+}
+
+void setThreadName(const char* name)
+{
+    if (!enabled()) {
+        return;
+    }
+    auto* buffer = threadBuffer();
+    if (buffer->threadName.load(std::memory_order_relaxed) != name) {
+        buffer->threadName.store(name, std::memory_order_release);
+    }
+}
+
+void complete(
+    const char* name, Clock::time_point begin, Clock::time_point end)
+{
+    if (!enabled()) {
+        return;
+    }
+    append('X', name, sinceStart(begin),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+            .count());
+}
+
+void instant(const char* name)
+{
+    if (!enabled()) {
+        return;
+    }
+    append('i', name, sinceStart(Clock::now()), 0);
+}
+
+bool writeTo(const std::filesystem::path& path)
+{
+    std::ofstream ofs(path, std::ios::trunc);
+    if (!ofs) {
+        return false;
+    }
+
+    std::string out;
+    auto it = std::back_inserter(out);
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) {
+            out.append(",\n");
+        }
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (const auto& buffer : buffers) {
+        const auto* threadName
+            = buffer->threadName.load(std::memory_order_acquire);
+        if (threadName != nullptr) {
+            separator();
+            fmt::format_to(it,
+                R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})",
+                buffer->tid, threadName);
+        }
+
+        auto written = buffer->written.load(std::memory_order_acquire);
+        auto begin = written > kEventsPerThread ? written - kEventsPerThread : 0;
+        for (auto n = begin; n < written; n++) {
+            const auto& ev = buffer->events[n % kEventsPerThread];
+
+            auto seqBefore = ev.seq.load(std::memory_order_acquire);
+            auto phase = ev.phase;
+            const auto* name = ev.name;
+            auto beginNs = ev.beginNs;
+            auto durationNs = ev.durationNs;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if ((seqBefore & 1U) != 0
+                || ev.seq.load(std::memory_order_relaxed) != seqBefore
+                || name == nullptr) {
+                continue; // Being overwritten right now, skip it
+            }
+
+            separator();
+            if (phase == 'X') {
+                fmt::format_to(it,
+                    R"({{"name":"{}","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})",
+                    name, buffer->tid, static_cast<double>(beginNs) / 1000.0,
+                    static_cast<double>(durationNs) / 1000.0);
+            } else {
+                fmt::format_to(it,
+                    R"({{"name":"{}","ph":"i","s":"t","pid":1,"tid":{},"ts":{:.3f}}})",
+                    name, buffer->tid, static_cast<double>(beginNs) / 1000.0);
+            }
+        }
+    }
+    out.append("\n]}\n");
+
+    ofs << out;
+    return static_cast<bool>(ofs);
+}
+}
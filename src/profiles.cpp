@@ -0,0 +1,142 @@
+#include "profiles.h"
+
+#include "channels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace vector_audio::profiles {
+
+namespace {
+    bool sameLetter(char a, char b)
+    {
+        return std::toupper(static_cast<unsigned char>(a))
+            == std::toupper(static_cast<unsigned char>(b));
+    }
+
+    std::optional<audio::StationState> loadStation(const toml::value& entry)
+    {
+        audio::StationState state;
+        state.callsign = toml::find_or<std::string>(entry, "callsign", "");
+        auto frequency = channels::parseName(
+            toml::find_or<std::string>(entry, "frequency", ""));
+        if (state.callsign.empty() || !frequency) {
+            return std::nullopt;
+        }
+
+        state.frequencyHz = *frequency;
+        state.rx = toml::find_or<bool>(entry, "rx", true);
+        state.tx = toml::find_or<bool>(entry, "tx", false);
+        state.xc = toml::find_or<bool>(entry, "xc", false);
+        state.onHeadset = toml::find_or<bool>(entry, "headset", true);
+        return state;
+    }
+}
+
+bool matches(std::string_view pattern, std::string_view callsign)
+{
+    // Iterative glob, backtracking to the last * on a mismatch
+    size_t p = 0;
+    size_t c = 0;
+    size_t star = std::string_view::npos;
+    size_t starMatch = 0;
+    while (c < callsign.size()) {
+        if (p < pattern.size()
+            && (pattern[p] == '?' || sameLetter(pattern[p], callsign[c]))) {
+            p++;
+            c++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            starMatch = c;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            c = ++starMatch;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+std::vector<Profile> load(const toml::value& config)
+{
+    std::vector<Profile> profiles;
+    if (!config.is_table() || !config.contains("profiles")
+        || !config.at("profiles").is_array()) {
+        return profiles;
+    }
+
+    for (const auto& entry : config.at("profiles").as_array()) {
+        Profile profile;
+        profile.pattern = toml::find_or<std::string>(entry, "pattern", "");
+        if (profile.pattern.empty()) {
+            spdlog::warn("Skipping a profile without a callsign pattern");
+            continue;
+        }
+        profile.radioGain = toml::find_or<int>(entry, "radio_gain", 100);
+
+        if (entry.contains("stations") && entry.at("stations").is_array()) {
+            for (const auto& station : entry.at("stations").as_array()) {
+                if (auto state = loadStation(station)) {
+                    profile.stations.push_back(std::move(*state));
+                } else {
+                    spdlog::warn("Skipping a malformed station in profile {}",
+                        profile.pattern);
+                }
+            }
+        }
+        profiles.push_back(std::move(profile));
+    }
+    return profiles;
+}
+
+void store(toml::value& config, const std::vector<Profile>& profiles)
+{
+    toml::value list = toml::array {};
+    for (const auto& profile : profiles) {
+        toml::value stations = toml::array {};
+        for (const auto& state : profile.stations) {
+            toml::value station = toml::table {};
+            station["callsign"] = state.callsign;
+            station["frequency"] = channels::formatName(state.frequencyHz);
+            station["rx"] = state.rx;
+            station["tx"] = state.tx;
+            station["xc"] = state.xc;
+            station["headset"] = state.onHeadset;
+            stations.push_back(std::move(station));
+        }
+
+        toml::value entry = toml::table {};
+        entry["pattern"] = profile.pattern;
+        entry["radio_gain"] = profile.radioGain;
+        entry["stations"] = std::move(stations);
+        list.push_back(std::move(entry));
+    }
+    config["profiles"] = std::move(list);
+}
+
+const Profile* find(
+    const std::vector<Profile>& profiles, std::string_view callsign)
+{
+    auto it = std::find_if(profiles.begin(), profiles.end(),
+        [&](const Profile& p) { return matches(p.pattern, callsign); });
+    return it == profiles.end() ? nullptr : &*it;
+}
+
+void save(std::vector<Profile>& profiles, Profile profile)
+{
+    auto it = std::find_if(profiles.begin(), profiles.end(),
+        [&](const Profile& p) { return p.pattern == profile.pattern; });
+    if (it == profiles.end()) {
+        profiles.push_back(std::move(profile));
+    } else {
+        *it = std::move(profile);
+    }
+}
+}
@@ -0,0 +1,285 @@
+#include "sdk/local_socket.h"
+
+#include "perf/trace.h"
+
+#include <array>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace vector_audio::sdk {
+
+namespace asio = restinio::asio_ns;
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+namespace {
+    using local_socket = asio::local::stream_protocol::socket;
+
+    // One relayed connection, kept alive by its pending operations
+    class RelaySession : public std::enable_shared_from_this<RelaySession> {
+    public:
+        RelaySession(local_socket local, std::shared_ptr<RelayPeers> peers)
+            : pLocal(std::move(local))
+            , pRemote(pLocal.get_executor())
+            , pPeers(std::move(peers))
+        {
+        }
+
+        ~RelaySession()
+        {
+            if (pRegistered) {
+                pPeers->remove(pBoundTo);
+            }
+        }
+
+        RelaySession(const RelaySession&) = delete;
+        RelaySession& operator=(const RelaySession&) = delete;
+        RelaySession(RelaySession&&) = delete;
+        RelaySession& operator=(RelaySession&&) = delete;
+
+        void start(const asio::ip::tcp::endpoint& target)
+        {
+            // Bound first, so the server knows the endpoint before it
+            // accepts the connection
+            asio::error_code ec;
+            pRemote.open(target.protocol(), ec);
+            if (!ec) {
+                pRemote.bind(asio::ip::tcp::endpoint(target.address(), 0), ec);
+            }
+            if (!ec) {
+                pBoundTo = pRemote.local_endpoint(ec);
+            }
+            if (ec) {
+                spdlog::warn(
+                    "SDK socket relay could not bind: {}", ec.message());
+                close();
+                return;
+            }
+            pPeers->add(pBoundTo);
+            pRegistered = true;
+
+            pRemote.async_connect(
+                target, [self = shared_from_this()](const asio::error_code& ec) {
+                    if (ec) {
+                        spdlog::warn("SDK socket relay could not reach the "
+                                     "server: {}",
+                            ec.message());
+                        self->close();
+                        return;
+                    }
+                    asio::error_code ignored;
+                    self->pRemote.set_option(
+                        asio::ip::tcp::no_delay(true), ignored);
+                    self->pump(self->pLocal, self->pRemote, self->pUp);
+                    self->pump(self->pRemote, self->pLocal, self->pDown);
+                });
+        }
+
+    private:
+        static constexpr size_t kBufferSize = 16 * 1024;
+        using buffer_t = std::array<char, kBufferSize>;
+
+        local_socket pLocal;
+        asio::ip::tcp::socket pRemote;
+        std::shared_ptr<RelayPeers> pPeers;
+        asio::ip::tcp::endpoint pBoundTo;
+        bool pRegistered = false;
+        buffer_t pUp {};
+        buffer_t pDown {};
+
+        template <typename From, typename To>
+        void pump(From& from, To& to, buffer_t& buffer)
+        {
+            from.async_read_some(asio::buffer(buffer),
+                [self = shared_from_this(), &from, &to, &buffer](
+                    const asio::error_code& ec, size_t size) {
+                    if (ec) {
+                        // End of this direction, the other one may still
+                        // have a response to deliver
+                        asio::error_code ignored;
+                        to.shutdown(asio::socket_base::shutdown_send, ignored);
+                        return;
+                    }
+                    asio::async_write(to, asio::buffer(buffer.data(), size),
+                        [self, &from, &to, &buffer](
+                            const asio::error_code& ec, size_t /*written*/) {
+                            if (ec) {
+                                self->close();
+                                return;
+                            }
+                            self->pump(from, to, buffer);
+                        });
+                });
+        }
+
+        void close()
+        {
+            asio::error_code ignored;
+            pLocal.close(ignored);
+            pRemote.close(ignored);
+        }
+    };
+}
+#endif
+
+RelayPeers::RelayPeers(bool relayOnly)
+    : pRelayOnly(relayOnly)
+{
+}
+
+restinio::ip_blocker::inspection_result_t RelayPeers::inspect(
+    const restinio::ip_blocker::incoming_info_t& info) noexcept
+{
+    if (!pRelayOnly) {
+        return restinio::ip_blocker::allow();
+    }
+
+    std::lock_guard<std::mutex> lock(pMutex);
+    if (pEndpoints.count(info.remote_endpoint()) > 0) {
+        return restinio::ip_blocker::allow();
+    }
+    spdlog::warn("Refused an SDK connection from port {}, the SDK is only "
+                 "served on its socket",
+        info.remote_endpoint().port());
+    return restinio::ip_blocker::deny();
+}
+
+void RelayPeers::add(const asio::ip::tcp::endpoint& endpoint)
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+    pEndpoints.insert(endpoint);
+}
+
+void RelayPeers::remove(const asio::ip::tcp::endpoint& endpoint)
+{
+    std::lock_guard<std::mutex> lock(pMutex);
+    pEndpoints.erase(endpoint);
+}
+
+LocalSocketRelay::LocalSocketRelay(std::filesystem::path path,
+    unsigned int mode, asio::ip::tcp::endpoint target,
+    std::shared_ptr<RelayPeers> peers)
+    : pPath(std::move(path))
+    , pMode(mode)
+    , pTarget(std::move(target))
+    , pPeers(std::move(peers))
+{
+}
+
+LocalSocketRelay::~LocalSocketRelay()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    asio::post(pIo, [this]() {
+        asio::error_code ignored;
+        pAcceptor.close(ignored);
+    });
+#endif
+    pIo.stop();
+    if (pThread.joinable()) {
+        pThread.join();
+    }
+
+    if (pBound) {
+        std::error_code ignored;
+        std::filesystem::remove(pPath, ignored);
+    }
+}
+
+bool LocalSocketRelay::isSupported()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool LocalSocketRelay::start()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    if (!removeStale()) {
+        return false;
+    }
+
+    try {
+        asio::local::stream_protocol::endpoint endpoint(pPath.string());
+        pAcceptor.open(endpoint.protocol());
+        pAcceptor.bind(endpoint);
+        pBound = true;
+
+        // Nobody can connect before listen(), so the mode is in place for
+        // the first client
+        std::filesystem::permissions(pPath,
+            static_cast<std::filesystem::perms>(pMode)
+                & std::filesystem::perms::mask);
+        pAcceptor.listen();
+    } catch (const std::exception& ex) {
+        spdlog::error(
+            "Could not open the SDK socket {}: {}", pPath.string(), ex.what());
+        return false;
+    }
+
+    accept();
+    pThread = std::thread([this]() {
+        perf::trace::setThreadName("sdk_socket");
+        pIo.run();
+    });
+    spdlog::info("Serving the SDK on {} (mode {:o})", pPath.string(), pMode);
+    return true;
+#else
+    spdlog::error("Unix domain sockets are not available on this platform, "
+                  "the SDK socket {} is not served",
+        pPath.string());
+    return false;
+#endif
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+void LocalSocketRelay::accept()
+{
+    pAcceptor.async_accept(
+        [this](const asio::error_code& ec, local_socket socket) {
+            if (ec == asio::error::operation_aborted) {
+                return;
+            }
+            if (!ec) {
+                std::make_shared<RelaySession>(std::move(socket), pPeers)
+                    ->start(pTarget);
+            }
+            accept();
+        });
+}
+#endif
+
+bool LocalSocketRelay::removeStale()
+{
+#if defined(ASIO_HAS_LOCAL_SOCKETS) || defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    std::error_code fsError;
+    auto status = std::filesystem::symlink_status(pPath, fsError);
+    if (!std::filesystem::exists(status)) {
+        return true;
+    }
+    if (status.type() != std::filesystem::file_type::socket) {
+        spdlog::error("{} exists and is not a socket, the SDK socket is not "
+                      "served",
+            pPath.string());
+        return false;
+    }
+
+    asio::error_code ec;
+    local_socket probe(pIo);
+    probe.connect(asio::local::stream_protocol::endpoint(pPath.string()), ec);
+    if (!ec) {
+        spdlog::error("{} is in use by another instance, the SDK socket is "
+                      "not served",
+            pPath.string());
+        return false;
+    }
+
+    std::filesystem::remove(pPath, fsError);
+    return !fsError;
+#else
+    return true;
+#endif
+}
+}
@@ -1,7 +1,127 @@
 #include "sdk/sdk.h"
 
+#include "channels.h"
+
+#include <stdexcept>
+
 namespace vector_audio {
 
+namespace {
+    using sdk::types::ControlOperation;
+
+    // 119900000 in Hz, or a channel name such as 119.900 or 119900
+    int parseFrequency(const std::string& text)
+    {
+        if (auto frequency = channels::parseName(text)) {
+            return *frequency;
+        }
+
+        size_t end = 0;
+        int frequency = std::stoi(text, &end);
+        if (end != text.size()) {
+            throw std::invalid_argument("invalid frequency " + text);
+        }
+        return frequency;
+    }
+
+    int parseFrequency(const nlohmann::json& value)
+    {
+        if (value.is_string()) {
+            return parseFrequency(value.get<std::string>());
+        }
+        return value.get<int>();
+    }
+
+    ControlOperation::Kind parseKind(const std::string& op)
+    {
+        if (op == "add") {
+            return ControlOperation::Kind::kAdd;
+        }
+        if (op == "remove") {
+            return ControlOperation::Kind::kRemove;
+        }
+        if (op == "set") {
+            return ControlOperation::Kind::kSet;
+        }
+        if (op == "gain") {
+            return ControlOperation::Kind::kGain;
+        }
+        throw std::invalid_argument("unknown op " + op);
+    }
+
+    // {"callsign": "EDDF_TWR", "frequency": "119.900", "rx": true,
+    //  "tx": false, "xc": false, "headset": true}, every switch optional.
+    // {"gain": 120} for kGain.
+    ControlOperation parseOperation(
+        const nlohmann::json& body, ControlOperation::Kind kind)
+    {
+        ControlOperation operation;
+        operation.kind = kind;
+        if (kind == ControlOperation::Kind::kGain) {
+            operation.gain = body.at("gain").get<int>();
+            return operation;
+        }
+
+        if (body.contains("frequency")) {
+            operation.frequencyHz = parseFrequency(body.at("frequency"));
+        }
+        if (kind == ControlOperation::Kind::kAdd) {
+            operation.callsign = body.at("callsign").get<std::string>();
+        }
+
+        auto readSwitch = [&](const char* key, std::optional<bool>& field) {
+            if (body.contains(key)) {
+                field = body.at(key).get<bool>();
+            }
+        };
+        readSwitch("rx", operation.switches.rx);
+        readSwitch("tx", operation.switches.tx);
+        readSwitch("xc", operation.switches.xc);
+        readSwitch("headset", operation.switches.onHeadset);
+        return operation;
+    }
+
+    // Requests that change the session or the radios are only taken from
+    // this machine, the socket relay connects over loopback as well
+    bool isLocalPeer(const restinio::asio_ns::ip::tcp::endpoint& peer)
+    {
+        auto address = peer.address();
+        if (address.is_v6() && address.to_v6().is_v4_mapped()) {
+            address = restinio::asio_ns::ip::make_address_v4(
+                restinio::asio_ns::ip::v4_mapped, address.to_v6());
+        }
+        return address.is_loopback();
+    }
+
+    // PTT sender of a websocket, kept apart from the datagram senders which
+    // are address and port
+    uint64_t websocketSender(std::uint64_t connectionId)
+    {
+        return (uint64_t { 1 } << 63U) | connectionId;
+    }
+
+    // "CALLSIGN:123.450" for every station matching the predicate, comma
+    // separated. Needs shared::fetchedStationMutex.
+    template <typename Predicate>
+    std::pmr::string stationList(
+        std::pmr::memory_resource* resource, Predicate&& matches)
+    {
+        std::pmr::string out(resource);
+        for (const auto& f : shared::fetchedStations) {
+            if (!matches(f.getFrequencyHz())) {
+                continue;
+            }
+            if (!out.empty()) {
+                out += ',';
+            }
+            out += f.getCallsign();
+            out += ':';
+            out += f.getHumanFrequency();
+        }
+        return out;
+    }
+}
+
 SDK::SDK(const std::shared_ptr<afv_native::api::atcClient>& clientPtr)
 {
     this->pClient = clientPtr;
@@ -9,13 +129,7 @@ SDK::SDK(const std::shared_ptr<afv_native::api::atcClient>& clientPtr)
 
 SDK::~SDK()
 {
-    for (auto [id, ws] : this->pWsRegistry) {
-        ws->shutdown();
-        ws.reset();
-    }
-    this->pWsRegistry.clear();
-    this->pSDKServer->stop();
-    this->pSDKServer.reset();
+    this->stop();
     this->pRouter.reset();
 }
 
@@ -32,7 +146,60 @@ bool SDK::start()
     return false;
 }
 
-void SDK::loopCleanup(const std::vector<std::string>& liveReceivedCallsigns)
+void SDK::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->pWsRegistryMutex);
+        for (auto [id, ws] : this->pWsRegistry) {
+            ws->shutdown();
+            ws.reset();
+        }
+        this->pWsRegistry.clear();
+        perf::set(perf::Gauge::kWebsocketClients, 0);
+    }
+    this->pLocalRelay.reset();
+    if (this->pSDKServer) {
+        this->pSDKServer->stop();
+        this->pSDKServer.reset();
+    }
+}
+
+void SDK::setPollRequestHandler(std::function<void()> handler)
+{
+    pPollRequestHandler = std::move(handler);
+}
+
+void SDK::setSessionPushHandler(
+    std::function<void(const sdk::types::SessionPush&)> handler)
+{
+    pSessionPushHandler = std::move(handler);
+}
+
+void SDK::setRxHistory(const audio::RxHistory* history)
+{
+    pRxHistory = history;
+}
+
+void SDK::setPttCommandHandler(PttCommandHandler handler)
+{
+    pPttCommandHandler = std::move(handler);
+}
+
+void SDK::setPttSenderClosedHandler(std::function<void(uint64_t)> handler)
+{
+    pPttSenderClosedHandler = std::move(handler);
+}
+
+void SDK::setControlHandler(
+    std::function<sdk::types::ControlResult(
+        const std::vector<sdk::types::ControlOperation>&)>
+        handler)
+{
+    pControlHandler = std::move(handler);
+}
+
+void SDK::loopCleanup(
+    const std::pmr::vector<std::pmr::string>& liveReceivedCallsigns)
 {
     // Clear out the old API data every 300ms
     auto currentTime = std::chrono::high_resolution_clock::now();
@@ -43,9 +210,15 @@ void SDK::loopCleanup(const std::vector<std::string>& liveReceivedCallsigns)
         return;
     }
 
+    // Rebuilt in place, the string keeps its capacity between updates
     const std::lock_guard<std::mutex> lock(shared::transmittingMutex);
-    shared::currentlyTransmittingApiData
-        = absl::StrJoin(liveReceivedCallsigns, ",");
+    shared::currentlyTransmittingApiData.clear();
+    for (const auto& callsign : liveReceivedCallsigns) {
+        if (!shared::currentlyTransmittingApiData.empty()) {
+            shared::currentlyTransmittingApiData += ',';
+        }
+        shared::currentlyTransmittingApiData += callsign;
+    }
 
     shared::currentlyTransmittingApiTimer = currentTime;
 }
@@ -54,12 +227,51 @@ void SDK::buildServer()
 {
     this->buildRouter();
 
+    // Serving only the socket still needs the HTTP server behind it, it is
+    // then kept to an ephemeral loopback port that refuses anything but the
+    // relay
+    bool socketOnly = !shared::apiSocketPath.empty() && !shared::apiServerTcp;
+    auto address = socketOnly ? std::string("127.0.0.1")
+                              : shared::apiServerAddress;
+    auto port = static_cast<uint16_t>(socketOnly ? 0 : shared::apiServerPort);
+    pRelayPeers = std::make_shared<sdk::RelayPeers>(socketOnly);
+
+    // run_async() only returns once the server is listening
+    restinio::asio_ns::ip::tcp::endpoint bound;
     pSDKServer = restinio::run_async<>(restinio::own_io_context(),
         restinio::server_settings_t<serverTraits> {}
-            .port(shared::apiServerPort)
-            .address("0.0.0.0")
+            .port(port)
+            .address(address)
+            .acceptor_post_bind_hook(
+                [&bound](restinio::asio_ns::ip::tcp::acceptor& acceptor) {
+                    bound = acceptor.local_endpoint();
+                })
+            .ip_blocker(pRelayPeers)
             .request_handler(std::move(this->pRouter)),
         16U);
+
+    if (shared::apiSocketPath.empty()) {
+        return;
+    }
+
+    auto target = bound;
+    if (target.address().is_unspecified()) {
+        target.address(target.address().is_v6()
+                ? restinio::asio_ns::ip::address(
+                    restinio::asio_ns::ip::address_v6::loopback())
+                : restinio::asio_ns::ip::address(
+                    restinio::asio_ns::ip::address_v4::loopback()));
+    }
+
+    pLocalRelay = std::make_unique<sdk::LocalSocketRelay>(
+        shared::apiSocketPath, shared::apiSocketMode, target, pRelayPeers);
+    if (!pLocalRelay->start()) {
+        pLocalRelay.reset();
+        if (socketOnly) {
+            spdlog::error("The SDK is only served on its socket, it is not "
+                          "reachable");
+        }
+    }
 }
 
 void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
@@ -95,37 +307,70 @@ void SDK::handleAFVEventForWebsocket(sdk::types::Event event,
         // std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
         // Lock needed outside of this function due to it being called somewhere
         // where the mutex is already locked
+        jsonMessage["value"] = frequencyState();
 
-        std::vector<ns::Station> rxBar;
-        for (const auto& s : shared::fetchedStations) {
-            if (pClient->GetRxState(s.getFrequencyHz())) {
-                rxBar.push_back(s);
-            }
-        }
+        this->broadcastOnWebsocket(jsonMessage.dump());
 
-        std::vector<ns::Station> txBar;
-        for (const auto& s : shared::fetchedStations) {
-            if (pClient->GetTxState(s.getFrequencyHz())) {
-                txBar.push_back(s);
-            }
-        }
+        return;
+    }
+};
 
-        std::vector<ns::Station> xcBar;
-        for (const auto& s : shared::fetchedStations) {
-            if (pClient->GetXcState(s.getFrequencyHz())) {
-                xcBar.push_back(s);
-            }
-        }
+void SDK::handleWebsocketCommand(std::uint64_t connectionId,
+    const std::string& payload, perf::Clock::time_point receivedAt)
+{
+    if (!pPttCommandHandler) {
+        return;
+    }
 
-        jsonMessage["value"]["rx"] = std::move(rxBar);
-        jsonMessage["value"]["tx"] = std::move(txBar);
-        jsonMessage["value"]["xc"] = std::move(xcBar);
+    input::PttCommand command;
+    try {
+        auto message = nlohmann::json::parse(payload);
+        auto type = message.at("type").get<std::string>();
+        const auto& value = message.at("value");
+        if (type == "kPtt") {
+            command.kind = input::PttCommand::Kind::kPtt;
+            command.on = value.at("pressed").get<bool>();
+        } else if (type == "kTx") {
+            command.kind = input::PttCommand::Kind::kTx;
+            command.on = value.at("tx").get<bool>();
+            command.frequencyHz = value.at("frequency").get<int>();
+        } else {
+            return;
+        }
+        command.sequence = value.at("sequence").get<uint32_t>();
+    } catch (const nlohmann::json::exception& ex) {
+        spdlog::debug("Ignored websocket message: {}", ex.what());
+        return;
+    }
 
-        this->broadcastOnWebsocket(jsonMessage.dump());
+    pPttCommandHandler(websocketSender(connectionId), command, receivedAt);
+}
 
-        return;
+nlohmann::json SDK::frequencyState()
+{
+    // Serialised straight from the station list, without copying the
+    // stations into per bar vectors first
+    auto rxBar = nlohmann::json::array();
+    auto txBar = nlohmann::json::array();
+    auto xcBar = nlohmann::json::array();
+    for (const auto& s : shared::fetchedStations) {
+        if (pClient->GetRxState(s.getFrequencyHz())) {
+            rxBar.push_back(s);
+        }
+        if (pClient->GetTxState(s.getFrequencyHz())) {
+            txBar.push_back(s);
+        }
+        if (pClient->GetXcState(s.getFrequencyHz())) {
+            xcBar.push_back(s);
+        }
     }
-};
+
+    nlohmann::json state;
+    state["rx"] = std::move(rxBar);
+    state["tx"] = std::move(txBar);
+    state["xc"] = std::move(xcBar);
+    return state;
+}
 
 void SDK::buildRouter()
 {
@@ -145,6 +390,58 @@ void SDK::buildRouter()
     this->pRouter->http_get(mSDKCallUrl[sdkCall::kWebSocket],
         [&](auto req, auto /*params*/) { return handleWebSocketSDKCall(req); });
 
+    this->pRouter->http_get(
+        mSDKCallUrl[sdkCall::kMetrics], [&](auto req, auto /*params*/) {
+            return SDK::handleMetricsSDKCall(req);
+        });
+
+    this->pRouter->http_get(
+        mSDKCallUrl[sdkCall::kStartup], [&](auto req, auto /*params*/) {
+            return SDK::handleStartupSDKCall(req);
+        });
+
+    this->pRouter->http_post(mSDKCallUrl[sdkCall::kPoll],
+        [&](auto req, auto /*params*/) { return this->handlePollSDKCall(req); });
+
+    this->pRouter->http_post(
+        mSDKCallUrl[sdkCall::kSession], [&](auto req, auto /*params*/) {
+            return this->handleSessionSDKCall(req);
+        });
+
+    this->pRouter->http_get(
+        mSDKCallUrl[sdkCall::kHistory], [&](auto req, auto /*params*/) {
+            return this->handleHistorySDKCall(req);
+        });
+
+    using Kind = sdk::types::ControlOperation::Kind;
+
+    this->pRouter->http_post(
+        mSDKCallUrl[sdkCall::kStations], [&](auto req, auto /*params*/) {
+            return this->handleControlSDKCall(req, Kind::kAdd);
+        });
+
+    this->pRouter->http_post(
+        mSDKCallUrl[sdkCall::kStation], [&](auto req, auto params) {
+            return this->handleControlSDKCall(
+                req, Kind::kSet, std::string(params["frequency"]));
+        });
+
+    this->pRouter->http_delete(
+        mSDKCallUrl[sdkCall::kStation], [&](auto req, auto params) {
+            return this->handleControlSDKCall(
+                req, Kind::kRemove, std::string(params["frequency"]));
+        });
+
+    this->pRouter->http_post(
+        mSDKCallUrl[sdkCall::kGain], [&](auto req, auto /*params*/) {
+            return this->handleControlSDKCall(req, Kind::kGain);
+        });
+
+    this->pRouter->http_post(
+        mSDKCallUrl[sdkCall::kBatch], [&](auto req, auto /*params*/) {
+            return this->handleControlSDKCall(req, std::nullopt);
+        });
+
     this->pRouter->non_matched_request_handler([](auto req) {
         return req->create_response().set_body(shared::kClientName).done();
     });
@@ -163,6 +460,8 @@ void SDK::buildRouter()
 restinio::request_handling_status_t SDK::handleTransmittingSDKCall(
     const restinio::request_handle_t& req)
 {
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
     const std::lock_guard<std::mutex> lock(shared::transmittingMutex);
     return req->create_response()
         .set_body(shared::currentlyTransmittingApiData)
@@ -172,66 +471,54 @@ restinio::request_handling_status_t SDK::handleTransmittingSDKCall(
 restinio::request_handling_status_t SDK::handleRxSDKCall(
     const restinio::request_handle_t& req)
 {
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
     if (!pClient->IsVoiceConnected()) {
         return req->create_response().set_body("").done();
     }
 
+    perf::Arena<kRequestArenaSize> arena;
     std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+    auto out = stationList(arena.resource(),
+        [&](int frequencyHz) { return pClient->GetRxState(frequencyHz); });
 
-    std::string out;
-    for (const auto& f : shared::fetchedStations) {
-        if (!pClient->GetRxState(f.getFrequencyHz())) {
-            continue;
-        }
-        out += f.getCallsign() + ":" + f.getHumanFrequency() + ",";
-    }
-
-    if (!out.empty()) {
-        if (out.back() == ',') {
-            out.pop_back();
-        }
-    }
-
-    return req->create_response().set_body(out).done();
+    return req->create_response().set_body(std::string(out)).done();
 };
 
 restinio::request_handling_status_t SDK::handleTxSDKCall(
     const restinio::request_handle_t& req)
 {
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
     if (!pClient->IsVoiceConnected()) {
         return req->create_response().set_body("").done();
     }
 
+    perf::Arena<kRequestArenaSize> arena;
     std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+    auto out = stationList(arena.resource(),
+        [&](int frequencyHz) { return pClient->GetTxState(frequencyHz); });
 
-    std::string out;
-    for (const auto& f : shared::fetchedStations) {
-        if (!pClient->GetTxState(f.getFrequencyHz())) {
-            continue;
-        }
-        out += f.getCallsign() + ":" + f.getHumanFrequency() + ",";
-    }
-
-    if (!out.empty()) {
-        if (out.back() == ',') {
-            out.pop_back();
-        }
-    }
-
-    return req->create_response().set_body(out).done();
+    return req->create_response().set_body(std::string(out)).done();
 }
 
 restinio::request_handling_status_t SDK::handleWebSocketSDKCall(
     const restinio::request_handle_t& req)
 {
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
     if (restinio::http_connection_header_t::upgrade
         != req->header().connection()) {
         return restinio::request_rejected();
     }
 
+    // PTT commands follow the datagram port and are only taken from this
+    // machine, other clients still get the state updates
+    bool acceptsCommands = isLocalPeer(req->remote_endpoint());
+
     auto wsh = restinio::websocket::basic::upgrade<serverTraits>(*req,
         restinio::websocket::basic::activation_t::immediate,
-        [&](auto wsh, auto m) {
+        [this, acceptsCommands](auto wsh, auto m) {
             if (restinio::websocket::basic::opcode_t::ping_frame
                 == m->opcode()) {
                 // Ping-Pong
@@ -243,12 +530,34 @@ restinio::request_handling_status_t SDK::handleWebSocketSDKCall(
                            connection_close_frame
                 == m->opcode()) {
                 // Close connection
-                this->pWsRegistry.erase(wsh->connection_id());
+                {
+                    std::lock_guard<std::mutex> lock(this->pWsRegistryMutex);
+                    this->pWsRegistry.erase(wsh->connection_id());
+                    perf::set(perf::Gauge::kWebsocketClients,
+                        static_cast<int64_t>(this->pWsRegistry.size()));
+                }
+
+                // A client gone while pressed would otherwise hold PTT
+                // until the sender times out
+                if (this->pPttSenderClosedHandler) {
+                    this->pPttSenderClosedHandler(
+                        websocketSender(wsh->connection_id()));
+                }
+            } else if (acceptsCommands
+                && restinio::websocket::basic::opcode_t::text_frame
+                    == m->opcode()) {
+                this->handleWebsocketCommand(
+                    wsh->connection_id(), m->payload(), perf::Clock::now());
             }
         });
 
     // Store websocket connection
-    this->pWsRegistry.emplace(wsh->connection_id(), wsh);
+    {
+        std::lock_guard<std::mutex> lock(this->pWsRegistryMutex);
+        this->pWsRegistry.emplace(wsh->connection_id(), wsh);
+        perf::set(perf::Gauge::kWebsocketClients,
+            static_cast<int64_t>(this->pWsRegistry.size()));
+    }
 
     // Upon connection, send the status of frequencies straight away
     {
@@ -263,17 +572,227 @@ restinio::request_handling_status_t SDK::handleWebSocketSDKCall(
 
 void SDK::broadcastOnWebsocket(const std::string& data)
 {
+    perf::ScopedTimer timer(perf::Metric::kWebsocketBroadcast);
     restinio::websocket::basic::message_t outgoingMessage;
     outgoingMessage.set_opcode(
         restinio::websocket::basic::opcode_t::text_frame);
     outgoingMessage.set_payload(data);
 
+    std::lock_guard<std::mutex> lock(this->pWsRegistryMutex);
     for (auto& [id, ws] : this->pWsRegistry) {
         try {
             ws->send_message(outgoingMessage);
+            perf::increment(perf::Counter::kWebsocketMessagesSent);
+            perf::increment(perf::Counter::kWebsocketBytesSent, data.size());
         } catch (const std::exception& ex) {
             spdlog::error("Failed to send data to websocket: {}", ex.what());
         }
     }
 };
+
+restinio::request_handling_status_t SDK::handleMetricsSDKCall(
+    const restinio::request_handle_t& req)
+{
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
+    return req->create_response()
+        .append_header(
+            restinio::http_field::content_type, perf::kOpenMetricsContentType)
+        .set_body(perf::renderOpenMetrics())
+        .done();
+}
+
+restinio::request_handling_status_t SDK::handleStartupSDKCall(
+    const restinio::request_handle_t& req)
+{
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
+
+    auto firstFrameUs = perf::startup::firstFrameUs();
+    nlohmann::json report;
+    report["first_frame_ms"] = firstFrameUs < 0
+        ? nlohmann::json(nullptr)
+        : nlohmann::json(static_cast<double>(firstFrameUs) / 1000.0);
+    report["stages"] = nlohmann::json::array();
+    for (const auto& stage : perf::startup::stages()) {
+        report["stages"].push_back({ { "name", stage.name },
+            { "thread", stage.onMainThread ? "main" : "worker" },
+            { "start_ms", static_cast<double>(stage.beginUs) / 1000.0 },
+            { "duration_ms", static_cast<double>(stage.durationUs) / 1000.0 } });
+    }
+
+    return req->create_response()
+        .append_header(restinio::http_field::content_type, "application/json")
+        .set_body(report.dump())
+        .done();
+}
+
+restinio::request_handling_status_t SDK::handlePollSDKCall(
+    const restinio::request_handle_t& req)
+{
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
+
+    if (!pPollRequestHandler) {
+        return req->create_response(restinio::status_service_unavailable())
+            .done();
+    }
+
+    pPollRequestHandler();
+    return req->create_response(restinio::status_accepted()).done();
+}
+
+restinio::request_handling_status_t SDK::handleSessionSDKCall(
+    const restinio::request_handle_t& req)
+{
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
+
+    if (!isLocalPeer(req->remote_endpoint())) {
+        return req->create_response(restinio::status_forbidden()).done();
+    }
+    if (!pSessionPushHandler) {
+        return req->create_response(restinio::status_service_unavailable())
+            .done();
+    }
+
+    // {"connected": true, "callsign": "EDDF_TWR", "frequency": 119900000,
+    //  "facility": 4, "latitude": 50.03, "longitude": 8.57}
+    // Only "connected" is required when disconnecting.
+    sdk::types::SessionPush session;
+    try {
+        auto body = nlohmann::json::parse(req->body());
+        session.connected = body.at("connected").get<bool>();
+        if (session.connected) {
+            session.callsign = body.at("callsign").get<std::string>();
+            session.frequencyHz = body.at("frequency").get<int>();
+            session.facility = body.value("facility", 0);
+            session.latitude = body.value("latitude", 0.0);
+            session.longitude = body.value("longitude", 0.0);
+        }
+    } catch (const nlohmann::json::exception& ex) {
+        return req->create_response(restinio::status_bad_request())
+            .set_body(ex.what())
+            .done();
+    }
+
+    if (session.connected
+        && (session.callsign.empty() || session.frequencyHz <= 0)) {
+        return req->create_response(restinio::status_bad_request())
+            .set_body("callsign and frequency are required")
+            .done();
+    }
+
+    pSessionPushHandler(session);
+    return req->create_response(restinio::status_no_content()).done();
+}
+
+restinio::request_handling_status_t SDK::handleHistorySDKCall(
+    const restinio::request_handle_t& req)
+{
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
+
+    if (pRxHistory == nullptr) {
+        return req->create_response(restinio::status_service_unavailable())
+            .done();
+    }
+
+    // Clients pass back "next" from the previous answer to only get newer
+    // transmissions. An entry still being received has a null duration, ask
+    // again from before its id to see it closed.
+    uint64_t since = 0;
+    try {
+        const auto query = restinio::parse_query(req->header().query());
+        if (query.has("since")) {
+            since = restinio::cast_to<uint64_t>(query["since"]);
+        }
+    } catch (const std::exception& ex) {
+        return req->create_response(restinio::status_bad_request())
+            .set_body(ex.what())
+            .done();
+    }
+
+    std::vector<audio::RxHistory::Entry> entries;
+    entries.reserve(audio::RxHistory::kCapacity);
+    pRxHistory->copySince(since, entries);
+
+    nlohmann::json history;
+    history["next"] = entries.empty() ? since : entries.back().id;
+    history["entries"] = nlohmann::json::array();
+    for (const auto& entry : entries) {
+        history["entries"].push_back({ { "id", entry.id },
+            { "callsign", entry.callsign.data() },
+            { "frequency", entry.frequencyHz }, { "start_ms", entry.startMs },
+            { "duration_ms",
+                entry.isOpen() ? nlohmann::json(nullptr)
+                               : nlohmann::json(entry.durationMs) } });
+    }
+
+    return req->create_response()
+        .append_header(restinio::http_field::content_type, "application/json")
+        .set_body(history.dump())
+        .done();
+}
+
+restinio::request_handling_status_t SDK::handleControlSDKCall(
+    const restinio::request_handle_t& req,
+    std::optional<sdk::types::ControlOperation::Kind> kind,
+    std::optional<std::string> frequency)
+{
+    perf::trace::setThreadName("sdk");
+    perf::ScopedTimer timer(perf::Metric::kSdkHandler);
+
+    if (!isLocalPeer(req->remote_endpoint())) {
+        return req->create_response(restinio::status_forbidden()).done();
+    }
+    if (!pControlHandler) {
+        return req->create_response(restinio::status_service_unavailable())
+            .done();
+    }
+
+    // A batch is {"operations": [{"op": "add", ...}, {"op": "gain", ...}]},
+    // with the same fields as the single operation endpoints
+    std::vector<ControlOperation> operations;
+    try {
+        auto body = req->body().empty() ? nlohmann::json::object()
+                                        : nlohmann::json::parse(req->body());
+        if (kind) {
+            auto operation = parseOperation(body, *kind);
+            if (frequency) {
+                operation.frequencyHz = parseFrequency(*frequency);
+            }
+            operations.push_back(std::move(operation));
+        } else {
+            for (const auto& entry : body.at("operations")) {
+                operations.push_back(parseOperation(
+                    entry, parseKind(entry.at("op").get<std::string>())));
+            }
+        }
+    } catch (const std::exception& ex) {
+        return req->create_response(restinio::status_bad_request())
+            .set_body(ex.what())
+            .done();
+    }
+
+    auto result = pControlHandler(operations);
+    if (!result.error.empty()) {
+        return req->create_response(restinio::status_conflict())
+            .set_body(result.error)
+            .done();
+    }
+
+    nlohmann::json state;
+    {
+        std::lock_guard<std::mutex> lock(shared::fetchedStationMutex);
+        state = frequencyState();
+    }
+    state["version"] = result.version;
+    state["applied"] = result.applied;
+
+    return req->create_response()
+        .append_header(restinio::http_field::content_type, "application/json")
+        .set_body(state.dump())
+        .done();
+}
 }
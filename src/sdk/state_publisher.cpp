@@ -0,0 +1,136 @@
+#include "sdk/state_publisher.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <spdlog/spdlog.h>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vector_audio::sdk {
+
+namespace {
+    // Everything after the sequence and the writer pid changes with the
+    // state, the fields before it are written once
+    constexpr size_t kStateOffset = offsetof(va_state, connected);
+    constexpr size_t kWriteOffset = offsetof(va_state, updated_at_ms);
+}
+
+StatePublisher::StatePublisher(std::string name, unsigned int mode)
+    : pName(std::move(name))
+    , pMode(mode)
+{
+}
+
+StatePublisher::~StatePublisher()
+{
+#ifndef _WIN32
+    if (pShared == nullptr) {
+        return;
+    }
+
+    // Readers that keep it mapped see a disconnected client, new ones do
+    // not find it anymore
+    write(va_state {});
+    munmap(pShared, sizeof(va_state));
+    shm_unlink(pName.c_str());
+#endif
+}
+
+bool StatePublisher::isSupported()
+{
+#ifndef _WIN32
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool StatePublisher::start()
+{
+#ifndef _WIN32
+    int fd = shm_open(pName.c_str(), O_CREAT | O_RDWR, pMode);
+    if (fd < 0) {
+        spdlog::error("Could not open the radio state shared memory {}: {}",
+            pName, std::strerror(errno));
+        return false;
+    }
+
+    // A block left behind by a crash keeps its old mode otherwise
+    void* mapped = MAP_FAILED;
+    if (fchmod(fd, pMode) == 0 && ftruncate(fd, sizeof(va_state)) == 0) {
+        mapped = mmap(nullptr, sizeof(va_state), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+    }
+    int mapError = errno;
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        spdlog::error("Could not map the radio state shared memory {}: {}",
+            pName, std::strerror(mapError));
+        shm_unlink(pName.c_str());
+        return false;
+    }
+
+    pShared = static_cast<va_state*>(mapped);
+    std::memset(pShared, 0, sizeof(va_state));
+    pShared->magic = VA_STATE_MAGIC;
+    pShared->version = VA_STATE_VERSION;
+    pShared->size = sizeof(va_state);
+    pShared->writer_pid = static_cast<uint32_t>(getpid());
+    write(va_state {});
+
+    spdlog::info("Publishing the radio state in shared memory {} (mode {:o})",
+        pName, pMode);
+    return true;
+#else
+    spdlog::error("Shared memory is not available on this platform, the "
+                  "radio state is not published");
+    return false;
+#endif
+}
+
+void StatePublisher::publish(const va_state& state)
+{
+    if (pShared == nullptr) {
+        return;
+    }
+
+    const auto* next = reinterpret_cast<const char*>(&state) + kStateOffset;
+    const auto* last = reinterpret_cast<const char*>(&pLast) + kStateOffset;
+    if (std::memcmp(next, last, sizeof(va_state) - kStateOffset) == 0) {
+        return;
+    }
+    write(state);
+}
+
+void StatePublisher::write(const va_state& state)
+{
+#ifndef _WIN32
+    using namespace std::chrono;
+
+    std::memcpy(reinterpret_cast<char*>(&pLast) + kStateOffset,
+        reinterpret_cast<const char*>(&state) + kStateOffset,
+        sizeof(va_state) - kStateOffset);
+    pLast.updated_at_ms = static_cast<uint64_t>(
+        duration_cast<milliseconds>(system_clock::now().time_since_epoch())
+            .count());
+
+    // Only this thread writes the sequence, readers retry while it is odd or
+    // when it moved under them
+    uint32_t sequence = pShared->sequence;
+    __atomic_store_n(&pShared->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    std::memcpy(reinterpret_cast<char*>(pShared) + kWriteOffset,
+        reinterpret_cast<const char*>(&pLast) + kWriteOffset,
+        sizeof(va_state) - kWriteOffset);
+    __atomic_store_n(&pShared->sequence, sequence + 2, __ATOMIC_RELEASE);
+#endif
+}
+}
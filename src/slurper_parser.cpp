@@ -0,0 +1,63 @@
+#include "slurper_parser.h"
+#include "channels.h"
+
+#include <absl/strings/numbers.h>
+#include <array>
+#include <charconv>
+
+namespace vector_audio::vatsim::slurper {
+
+std::optional<Connection> parseLine(std::string_view line)
+{
+    std::array<std::string_view, kMinFields> fields;
+    size_t count = 0;
+
+    while (count < kMinFields) {
+        auto comma = line.find(',');
+        fields[count++] = line.substr(0, comma);
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        line.remove_prefix(comma + 1);
+    }
+
+    if (count < kMinFields) {
+        return std::nullopt;
+    }
+
+    return Connection { fields[1], fields[2], fields[3], fields[5],
+        fields[6] };
+}
+
+bool parseFrequencyHz(std::string_view frequency, int& hz)
+{
+    auto parsed = channels::parseName(frequency);
+    if (!parsed) {
+        return false;
+    }
+    hz = *parsed;
+    return true;
+}
+
+bool parseCoordinate(std::string_view value, double& out)
+{
+    // std::from_chars for doubles is missing from the macOS toolchain
+    if (!absl::SimpleAtod(
+            absl::string_view(value.data(), value.size()), &out)) {
+        out = 0.0;
+        return false;
+    }
+    return true;
+}
+
+std::optional<int> parseTypeCode(std::string_view type)
+{
+    int code = 0;
+    auto [ptr, ec]
+        = std::from_chars(type.data(), type.data() + type.size(), code, 16);
+    if (ec != std::errc() || ptr == type.data()) {
+        return std::nullopt;
+    }
+    return code;
+}
+}
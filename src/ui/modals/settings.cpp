@@ -162,8 +162,7 @@ void vector_audio::ui::modals::Settings::render(
 
             ImGui::TextUnformatted("Push to talk key: ");
             std::string pttKeyName;
-            if (shared::ptt == sf::Keyboard::Scan::Unknown
-                && shared::joyStickId == -1) {
+            if (shared::ptt == sf::Keyboard::Scan::Unknown) {
                 pttKeyName = "Not set";
             } else if (shared::ptt != sf::Keyboard::Scan::Unknown) {
 #ifdef SFML_SYSTEM_WINDOWS
@@ -177,9 +176,6 @@ void vector_audio::ui::modals::Settings::render(
                 } else {
                     pttKeyName = "Key set: " + keyDesc;
                 }
-            } else if (shared::joyStickId != -1) {
-                pttKeyName = fmt::format("Joystick {} Button {}",
-                    shared::joyStickId, shared::joyStickPtt);
             }
 
             ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
@@ -198,6 +194,9 @@ void vector_audio::ui::modals::Settings::render(
             }
             vector_audio::style::button_reset_colour();
 
+            ImGui::NewLine();
+            renderJoystickBindings();
+
             ImGui::NewLine();
 
             ImGui::Checkbox(
@@ -207,6 +206,13 @@ void vector_audio::ui::modals::Settings::render(
                 "Enable this option to make the VectorAudio\nwindow stay on "
                 "top of other windows.");
 
+            ImGui::Checkbox("Show Performance Overlay",
+                &vector_audio::shared::showPerfOverlay);
+            ImGui::SameLine();
+            vector_audio::util::HelpMarker(
+                "Shows timings of the main hot paths (frame, events,\n"
+                "datafile, SDK). Also toggled with Ctrl+Shift+P.");
+
             ImGui::TableNextColumn();
 
             ImGui::Text("Audio configuration");
@@ -226,15 +232,9 @@ void vector_audio::ui::modals::Settings::render(
                         "Default", vector_audio::shared::mAudioApi == -1)) {
                     vector_audio::shared::mAudioApi = -1;
                     if (mClient) {
-                        // set the Audio API and update the available inputs and
-                        // outputs
+                        // set the Audio API, the available inputs and outputs
+                        // are enumerated again in the background
                         mClient->SetAudioApi(vector_audio::shared::mAudioApi);
-                        vector_audio::shared::availableInputDevices
-                            = mClient->GetAudioInputDevices(
-                                vector_audio::shared::mAudioApi);
-                        vector_audio::shared::availableOutputDevices
-                            = mClient->GetAudioOutputDevices(
-                                vector_audio::shared::mAudioApi);
                     }
                     vector_audio::shared::configAudioApi = "Default API";
                     vector_audio::Configuration::mConfig["audio"]["api"]
@@ -248,16 +248,10 @@ void vector_audio::ui::modals::Settings::render(
                             vector_audio::shared::mAudioApi == item.first)) {
                         vector_audio::shared::mAudioApi = item.first;
                         if (mClient) {
-                            // set the Audio API and update the available inputs
-                            // and outputs
+                            // set the Audio API, the available inputs and
+                            // outputs are enumerated again in the background
                             mClient->SetAudioApi(
                                 vector_audio::shared::mAudioApi);
-                            vector_audio::shared::availableInputDevices
-                                = mClient->GetAudioInputDevices(
-                                    vector_audio::shared::mAudioApi);
-                            vector_audio::shared::availableOutputDevices
-                                = mClient->GetAudioOutputDevices(
-                                    vector_audio::shared::mAudioApi);
                         }
                         vector_audio::shared::configAudioApi = item.second;
                         vector_audio::Configuration::mConfig["audio"]["api"]
@@ -395,6 +389,50 @@ void vector_audio::ui::modals::Settings::render(
                 ImGui::PopItemWidth();
             }
 
+            auto fallbackCombo = [](const char* label,
+                                     const std::vector<std::string>& devices,
+                                     std::string& selected,
+                                     const char* configKey) {
+                ImGui::PushItemWidth(-1.0F);
+                if (ImGui::BeginCombo(label,
+                        selected.empty() ? "None" : selected.c_str())) {
+                    if (ImGui::Selectable("None", selected.empty())) {
+                        selected.clear();
+                        vector_audio::Configuration::mConfig["audio"]
+                                                            [configKey]
+                            = selected;
+                    }
+                    for (const auto& driver : devices) {
+                        if (ImGui::Selectable(
+                                driver.c_str(), selected == driver)) {
+                            selected = driver;
+                            vector_audio::Configuration::mConfig["audio"]
+                                                                [configKey]
+                                = selected;
+                        }
+                    }
+
+                    ImGui::EndCombo();
+                }
+                ImGui::PopItemWidth();
+            };
+
+            ImGui::TextUnformatted("Fallback Input Device");
+            ImGui::SameLine();
+            vector_audio::util::HelpMarker(
+                "Optional: Used if the input or output device above\nstops "
+                "working while connected. Audio switches over\nwithout "
+                "leaving your frequencies.");
+            fallbackCombo("##Fallback Input Device",
+                vector_audio::shared::availableInputDevices,
+                vector_audio::shared::configFallbackInputDeviceName,
+                "fallback_input_device");
+            ImGui::TextUnformatted("Fallback Output Device");
+            fallbackCombo("##Fallback Output Device",
+                vector_audio::shared::availableOutputDevices,
+                vector_audio::shared::configFallbackOutputDeviceName,
+                "fallback_output_device");
+
             ImGui::NewLine();
 
             vector_audio::style::button_purple();
@@ -444,6 +482,7 @@ void vector_audio::ui::modals::Settings::render(
                 ImGui::CloseCurrentPopup();
 
                 shared::capturePttFlag = false;
+                shared::captureJoystickFlag = false;
             }
 
             ImGui::SameLine();
@@ -474,6 +513,7 @@ void vector_audio::ui::modals::Settings::render(
                 ImGui::CloseCurrentPopup();
 
                 shared::capturePttFlag = false;
+                shared::captureJoystickFlag = false;
             }
             vector_audio::style::button_reset_colour();
 
@@ -482,4 +522,64 @@ void vector_audio::ui::modals::Settings::render(
 
         ImGui::EndPopup();
     }
-}
\ No newline at end of file
+}
+
+void vector_audio::ui::modals::Settings::renderJoystickBindings()
+{
+    ImGui::TextUnformatted("Joystick buttons: ");
+    ImGui::SameLine();
+    vector_audio::util::HelpMarker(
+        "Every button keys PTT. With a frequency, a button transmits\non "
+        "that frequency only while it is held, for controllers.");
+
+    std::optional<size_t> removed;
+    for (size_t i = 0; i < shared::joystickBindings.size(); i++) {
+        const auto& binding = shared::joystickBindings[i];
+        auto device = binding.deviceName.empty() ? std::string("Any joystick")
+                                                 : binding.deviceName;
+        auto label = binding.frequencyHz == 0
+            ? fmt::format("{} button {}: PTT", device, binding.button)
+            : fmt::format("{} button {}: TX {}", device, binding.button,
+                channels::formatName(binding.frequencyHz));
+
+        ImGui::PushID(static_cast<int>(i));
+        if (ImGui::SmallButton("Remove")) {
+            removed = i;
+        }
+        ImGui::PopID();
+        ImGui::SameLine();
+        ImGui::TextUnformatted(label.c_str());
+    }
+
+    if (removed) {
+        shared::joystickBindings.erase(
+            shared::joystickBindings.begin()
+            + static_cast<std::ptrdiff_t>(*removed));
+        input::storeJoystickBindings(
+            Configuration::mConfig, shared::joystickBindings);
+        Configuration::write_config_async();
+    }
+
+    ImGui::PushItemWidth(-1.0F);
+    ImGui::InputTextWithHint("##joystick_frequency",
+        "TX frequency, empty for PTT", &mJoystickFrequency);
+    ImGui::PopItemWidth();
+
+    auto frequency = channels::parseName(mJoystickFrequency);
+    bool frequencyValid = mJoystickFrequency.empty() || frequency;
+
+    vector_audio::style::button_blue();
+    if (shared::captureJoystickFlag) {
+        if (ImGui::Button("Press a joystick button...", ImVec2(-1.0F, 0.0F))) {
+            shared::captureJoystickFlag = false;
+        }
+    } else {
+        ImGui::PushItemFlag(ImGuiItemFlags_Disabled, !frequencyValid);
+        if (ImGui::Button("Add Joystick Button", ImVec2(-1.0F, 0.0F))) {
+            shared::captureJoystickFrequencyHz = frequency.value_or(0);
+            shared::captureJoystickFlag = true;
+        }
+        ImGui::PopItemFlag();
+    }
+    vector_audio::style::button_reset_colour();
+}
@@ -1,39 +1,75 @@
 #include "updater.h"
 
+#include "config.h"
 #include "shared.h"
 
 #include <spdlog/spdlog.h>
+#include <toml.hpp>
 
 namespace vector_audio {
 
-// This class is blocking on purpose, we want to update if needed before
-// anything
+// The last known result is read from disk so a mandatory update is still
+// enforced from the first frame, the network check then runs in the
+// background and refreshes it
 Updater::Updater()
     : pCli(pBaseUrl)
 {
-    // Check version file
-    auto res = pCli.Get(pVersionUrl);
-    if (!res) {
+    pCli.set_connection_timeout(std::chrono::seconds(3));
+    pCli.set_read_timeout(std::chrono::seconds(5));
+
+    load_cache();
+
+    pCheckThread
+        = std::make_unique<std::thread>(&Updater::check_for_update, this);
+}
+
+Updater::~Updater()
+{
+    pCli.stop();
+    if (pCheckThread && pCheckThread->joinable()) {
+        pCheckThread->join();
+    }
+}
+
+void Updater::check_for_update()
+{
+    auto latestVersion = fetch_version(pVersionUrl);
+    if (!latestVersion) {
         spdlog::critical(
             "Cannot access updater endpoint, please update manually!");
         return;
     }
 
-    if (res->status != 200) {
-        spdlog::critical(
-            "Updater endpoint did not return ok, please update manually!");
+    auto betaVersion = fetch_version(pBetaVersionUrl);
+    if (!betaVersion) {
+        spdlog::warn("Cannot access updater beta endpoint!");
+    }
 
-        return;
+    apply_versions(*latestVersion, betaVersion);
+    save_cache(*latestVersion, betaVersion);
+}
+
+std::optional<std::string> Updater::fetch_version(const std::string& url)
+{
+    auto res = pCli.Get(url);
+    if (!res || res->status != 200) {
+        return std::nullopt;
     }
 
+    std::string cleanBody = res->body;
+    absl::StripAsciiWhitespace(&cleanBody);
+    return cleanBody;
+}
+
+void Updater::apply_versions(const std::string& latestVersion,
+    const std::optional<std::string>& betaVersion)
+{
     semver::version currentVersion;
+    semver::version newVersion;
 
     try {
         currentVersion = semver::version { std::string(VECTOR_VERSION) };
-        
-        std::string cleanBody = res->body;
-        absl::StripAsciiWhitespace(&cleanBody);
-        pNewVersion = semver::version { cleanBody };
+        newVersion = semver::version { latestVersion };
     } catch (std::invalid_argument& ex) {
         spdlog::critical(
             "Cannot parse updater version, please update manually!");
@@ -41,36 +77,85 @@ Updater::Updater()
         return;
     }
 
-    if (pNewVersion > currentVersion) {
+    {
+        std::lock_guard<std::mutex> lock(mResultMutex);
+        pNewVersion = newVersion;
+    }
+
+    if (newVersion > currentVersion) {
         pNeedUpdate = true;
         return; // We don't check for beta as this is a mandatory update
     }
+    pNeedUpdate = false;
 
-    // isBetaAvailable
-    auto betaRes = pCli.Get(pBetaVersionUrl);
-
-    if (betaRes->status != 200) {
-        spdlog::warn("Cannot access updater beta endpoint!");
+    if (!betaVersion) {
         return;
     }
 
+    semver::version newBetaVersion;
     try {
-        std::string cleanBody = betaRes->body;
-        absl::StripAsciiWhitespace(&cleanBody);
-        pBetaVersion = semver::version { cleanBody };
+        newBetaVersion = semver::version { *betaVersion };
     } catch (std::invalid_argument& ex) {
         spdlog::warn("Cannot parse updater beta version!");
         spdlog::warn(ex.what());
         return;
     }
 
-    if (pBetaVersion <= currentVersion && currentVersion != pNewVersion) {
+    std::lock_guard<std::mutex> lock(mResultMutex);
+    if (newBetaVersion <= currentVersion && currentVersion != newVersion) {
         // We are using the beta version
         shared::isUsingBeta = true;
-        shared::betaVersionString = pBetaVersion.to_string();
-    } else if (pBetaVersion > currentVersion) {
+        shared::isBetaAvailable = false;
+        shared::betaVersionString = newBetaVersion.to_string();
+    } else if (newBetaVersion > currentVersion) {
+        shared::isUsingBeta = false;
         shared::isBetaAvailable = true;
-        shared::betaVersionString = pBetaVersion.to_string();
+        shared::betaVersionString = newBetaVersion.to_string();
+    }
+}
+
+void Updater::load_cache()
+{
+    auto cachePath = Configuration::get_config_folder_path()
+        / std::filesystem::path(pCacheFileName);
+    if (!std::filesystem::exists(cachePath)) {
+        return;
+    }
+
+    try {
+        auto cache = toml::parse(cachePath);
+        auto latestVersion
+            = toml::find_or<std::string>(cache, "updater", "latest", "");
+        auto betaVersion
+            = toml::find_or<std::string>(cache, "updater", "beta", "");
+        if (latestVersion.empty()) {
+            return;
+        }
+
+        apply_versions(latestVersion,
+            betaVersion.empty() ? std::nullopt
+                                : std::optional<std::string>(betaVersion));
+    } catch (std::exception& ex) {
+        spdlog::warn("Could not read updater cache: {}", ex.what());
+    }
+}
+
+void Updater::save_cache(const std::string& latestVersion,
+    const std::optional<std::string>& betaVersion) const
+{
+    auto cachePath = Configuration::get_config_folder_path()
+        / std::filesystem::path(pCacheFileName);
+
+    toml::value cache;
+    cache["updater"]["latest"] = latestVersion;
+    if (betaVersion) {
+        cache["updater"]["beta"] = *betaVersion;
+    }
+
+    std::ofstream ofs(cachePath, std::ios::trunc);
+    ofs << cache;
+    if (!ofs) {
+        spdlog::warn("Could not write updater cache {}", cachePath.string());
     }
 }
 
@@ -85,6 +170,12 @@ bool Updater::need_update() const
 
 void Updater::draw()
 {
+    std::string newVersion;
+    {
+        std::lock_guard<std::mutex> lock(mResultMutex);
+        newVersion = pNewVersion.to_string();
+    }
+
     ImGui::Begin("VectorAudio Updater", nullptr,
         ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove
             | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse
@@ -93,7 +184,7 @@ void Updater::draw()
     ImGui::Text(
         "A new version of VectorAudio is available, please update it! (%s -> "
         "%s)",
-        VECTOR_VERSION, pNewVersion.to_string().c_str());
+        VECTOR_VERSION, newVersion.c_str());
 
     ImGui::NewLine();
     ImGui::Separator();
@@ -107,6 +198,7 @@ void Updater::draw()
 
 void Updater::draw_beta_hint()
 {
+    std::lock_guard<std::mutex> lock(mResultMutex);
     if (shared::isUsingBeta) {
         ImGui::NewLine();
 
@@ -127,4 +219,4 @@ void Updater::draw_beta_hint()
         ImGui::NewLine();
     }
 }
-} // namespace vector_audio
\ No newline at end of file
+} // namespace vector_audio
@@ -0,0 +1,170 @@
+// Channel table benchmark
+//
+// Compares the constexpr channel table against the previous frequency
+// helpers: RadioSimulation::round8_33kHzChannel, the std::to_string and
+// substr formatting of ns::Station::build and the std::stoi parsing of
+// App::addNewStation. Also checks that rounding gives the same result as
+// before on every kHz around the band.
+//
+// Usage: channel_bench [--iterations N]
+
+#include "channels.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+namespace channels = vector_audio::channels;
+
+// RadioSimulation as it was, from
+// https://github.com/swift-project/pilotclient/blob/main/src/blackmisc/aviation/comsystem.cpp
+// Under GPL v3 License
+bool isValid8_33kHzChannelLegacy(int fKHz)
+{
+    const int lastDigits = static_cast<int>(fKHz) % 100;
+    return fKHz % 5 == 0 && lastDigits != 20 && lastDigits != 45
+        && lastDigits != 70 && lastDigits != 95;
+}
+
+int round8_33kHzChannelLegacy(int fKHz)
+{
+    fKHz = fKHz / 1000;
+    if (!isValid8_33kHzChannelLegacy(fKHz)) {
+        const int diff = static_cast<int>(fKHz) % 5;
+        int lower = fKHz - diff;
+        if (!isValid8_33kHzChannelLegacy(lower)) {
+            lower -= 5;
+        }
+
+        int upper = fKHz + (5 - diff);
+        if (!isValid8_33kHzChannelLegacy(upper)) {
+            upper += 5;
+        }
+
+        const int lowerDiff = std::abs(fKHz - lower);
+        const int upperDiff = std::abs(fKHz - upper);
+
+        fKHz = lowerDiff < upperDiff ? lower : upper;
+        fKHz = std::clamp(fKHz, 118000, 136990);
+    }
+    return fKHz * 1000;
+}
+
+std::string formatLegacy(int freqHz)
+{
+    std::string temp = std::to_string(freqHz / 1000);
+    return temp.substr(0, 3) + "." + temp.substr(3, 7);
+}
+
+int parseLegacy(const std::string& text)
+{
+    try {
+        return std::stoi(text) * 1000;
+    } catch (...) {
+        return 0;
+    }
+}
+
+template <typename Fn> double timeNsPerOp(int iterations, size_t ops, Fn&& fn)
+{
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        fn();
+    }
+    auto elapsed
+        = std::chrono::duration<double, std::nano>(Clock::now() - start);
+    return elapsed.count() / (static_cast<double>(iterations) * ops);
+}
+
+void report(const char* name, double legacyNs, double tableNs)
+{
+    std::cout << name << ": legacy " << legacyNs << " ns, table " << tableNs
+              << " ns, " << legacyNs / tableNs << "x\n";
+}
+}
+
+int main(int argc, char** argv)
+{
+    int iterations = 200;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: channel_bench [--iterations N]\n";
+            return 1;
+        }
+    }
+
+    // Rounding must not change, including around and outside of the band
+    for (int kHz = 100000; kHz <= 200000; kHz++) {
+        for (int hz : { kHz * 1000, kHz * 1000 + 333, kHz * 1000 + 999 }) {
+            if (channels::roundHz(hz) != round8_33kHzChannelLegacy(hz)) {
+                std::cerr << "Rounding mismatch on " << hz << ": "
+                          << channels::roundHz(hz) << " instead of "
+                          << round8_33kHzChannelLegacy(hz) << "\n";
+                return 1;
+            }
+        }
+    }
+
+    std::vector<int> inputs;
+    std::vector<int> names;
+    std::vector<std::string> texts;
+    for (int hz = 117000000; hz < 138000000; hz += 1000 + 333) {
+        inputs.push_back(hz);
+    }
+    for (const auto& channel : channels::kChannels) {
+        names.push_back(channel.nameKHz * 1000);
+        texts.push_back(std::to_string(channel.nameKHz));
+        if (formatLegacy(names.back()) != channels::formatName(names.back())
+            || parseLegacy(texts.back()) != channels::parseName(texts.back())) {
+            std::cerr << "Format or parse mismatch on " << names.back()
+                      << "\n";
+            return 1;
+        }
+    }
+
+    volatile long long sink = 0;
+
+    report("round", timeNsPerOp(iterations, inputs.size(), [&]() {
+        for (int hz : inputs) {
+            sink = sink + round8_33kHzChannelLegacy(hz);
+        }
+    }),
+        timeNsPerOp(iterations, inputs.size(), [&]() {
+            for (int hz : inputs) {
+                sink = sink + channels::roundHz(hz);
+            }
+        }));
+
+    report("format", timeNsPerOp(iterations, names.size(), [&]() {
+        for (int hz : names) {
+            sink = sink + static_cast<long long>(formatLegacy(hz).size());
+        }
+    }),
+        timeNsPerOp(iterations, names.size(), [&]() {
+            for (int hz : names) {
+                sink = sink
+                    + static_cast<long long>(channels::formatName(hz).size());
+            }
+        }));
+
+    report("parse", timeNsPerOp(iterations, texts.size(), [&]() {
+        for (const auto& text : texts) {
+            sink = sink + parseLegacy(text);
+        }
+    }),
+        timeNsPerOp(iterations, texts.size(), [&]() {
+            for (const auto& text : texts) {
+                sink = sink + channels::parseName(text).value_or(0);
+            }
+        }));
+
+    return 0;
+}
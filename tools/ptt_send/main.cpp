@@ -0,0 +1,82 @@
+// PTT panel stand-in
+//
+// Plays the part of a hardware panel: sends PTT datagrams to a running
+// VectorAudio. "hold" keeps PTT pressed for a while, repeating the state as
+// panels must, then releases it. Press-to-transmit latency is reported by
+// the ptt_external histogram on GET /metrics.
+//
+// Usage: ptt_send press|release
+//        ptt_send hold SECONDS
+//        ptt_send tx FREQUENCY_HZ on|off
+//        [--port PORT] may be given first, defaults to 49081
+//
+// Datagrams are sent from the fixed port 49082, so that successive runs are
+// the same sender and a release undoes an earlier press.
+
+#include "input/ptt_protocol.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <restinio/asio_include.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace asio = restinio::asio_ns;
+using vector_audio::input::PttCommand;
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int port = 49081;
+    if (args.size() >= 2 && args[0] == "--port") {
+        port = std::atoi(args[1].c_str());
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    asio::io_context io;
+    asio::ip::udp::socket socket(io,
+        asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 49082));
+    asio::ip::udp::endpoint target(
+        asio::ip::address_v4::loopback(), static_cast<uint16_t>(port));
+
+    // Seeded from the clock in milliseconds, so that a rerun is newer
+    auto sequence = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    auto send = [&](PttCommand command) {
+        command.sequence = ++sequence;
+        auto packet = vector_audio::input::encodePttPacket(command);
+        socket.send_to(asio::buffer(packet), target);
+    };
+
+    PttCommand command;
+    if (args.size() == 1 && (args[0] == "press" || args[0] == "release")) {
+        command.on = args[0] == "press";
+        send(command);
+    } else if (args.size() == 2 && args[0] == "hold") {
+        auto until = std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(
+                static_cast<int>(std::atof(args[1].c_str()) * 1000));
+        command.on = true;
+        while (std::chrono::steady_clock::now() < until) {
+            send(command);
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        }
+        command.on = false;
+        send(command);
+    } else if (args.size() == 3 && args[0] == "tx") {
+        command.kind = PttCommand::Kind::kTx;
+        command.frequencyHz = std::atoi(args[1].c_str());
+        command.on = args[2] == "on";
+        send(command);
+    } else {
+        std::cerr << "usage: ptt_send [--port PORT] press|release\n"
+                     "       ptt_send [--port PORT] hold SECONDS\n"
+                     "       ptt_send [--port PORT] tx FREQUENCY_HZ on|off\n";
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,244 @@
+// Link-time stand-in for afv_native::api::atcClient.
+//
+// The load generator links the real SDK server code against this file instead
+// of the afv_native library, so it can run without any audio device or VATSIM
+// connection. Every frequency added is reported as active with RX and TX on,
+// which is what the SDK handlers need to produce non-empty responses.
+
+#include "afv-native/atcClientWrapper.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+struct FakeFrequencyState {
+    std::string station;
+    bool rx = true;
+    bool tx = true;
+    bool xc = false;
+    bool onHeadset = true;
+};
+
+std::mutex fakeStateMutex;
+std::map<unsigned int, FakeFrequencyState> fakeFrequencies;
+std::function<void(afv_native::ClientEventType, void*, void*)> fakeCallback;
+bool fakePtt = false;
+
+bool withFrequency(unsigned int freq, bool FakeFrequencyState::*field)
+{
+    const std::lock_guard<std::mutex> lock(fakeStateMutex);
+    auto it = fakeFrequencies.find(freq);
+    return it != fakeFrequencies.end() && it->second.*field;
+}
+
+void setFrequency(unsigned int freq, bool FakeFrequencyState::*field, bool v)
+{
+    const std::lock_guard<std::mutex> lock(fakeStateMutex);
+    auto it = fakeFrequencies.find(freq);
+    if (it != fakeFrequencies.end()) {
+        it->second.*field = v;
+    }
+}
+}
+
+namespace afv_native::api {
+
+void setLogger(afv_native::modern_log_fn /*gLogger*/) { }
+
+atcClient::atcClient(std::string /*clientName*/, std::string /*resourcePath*/)
+{
+}
+
+atcClient::~atcClient() = default;
+
+bool atcClient::IsInitialized() { return true; }
+
+void atcClient::SetCredentials(std::string /*username*/, std::string /*password*/)
+{
+}
+
+void atcClient::SetCallsign(std::string /*callsign*/) { }
+
+void atcClient::SetClientPosition(
+    double /*lat*/, double /*lon*/, double /*amslm*/, double /*aglm*/)
+{
+}
+
+bool atcClient::IsVoiceConnected() { return true; }
+
+bool atcClient::IsAPIConnected() { return true; }
+
+bool atcClient::Connect() { return true; }
+
+void atcClient::Disconnect() { }
+
+void atcClient::SetAudioApi(unsigned int /*api*/) { }
+
+std::map<unsigned int, std::string> atcClient::GetAudioApis()
+{
+    return { { 0, "Fake API" } };
+}
+
+void atcClient::SetAudioInputDevice(std::string /*inputDevice*/) { }
+
+std::vector<std::string> atcClient::GetAudioInputDevices(
+    unsigned int /*mAudioApi*/)
+{
+    return { "Fake input" };
+}
+
+std::string atcClient::GetDefaultAudioInputDevice(unsigned int /*mAudioApi*/)
+{
+    return "Fake input";
+}
+
+void atcClient::SetAudioOutputDevice(std::string /*outputDevice*/) { }
+
+void atcClient::SetAudioSpeakersOutputDevice(std::string /*outputDevice*/) { }
+
+std::vector<std::string> atcClient::GetAudioOutputDevices(
+    unsigned int /*mAudioApi*/)
+{
+    return { "Fake output" };
+}
+
+std::string atcClient::GetDefaultAudioOutputDevice(unsigned int /*mAudioApi*/)
+{
+    return "Fake output";
+}
+
+double atcClient::GetInputPeak() const { return -40.0; }
+
+double atcClient::GetInputVu() const { return -40.0; }
+
+void atcClient::SetEnableInputFilters(bool /*enableInputFilters*/) { }
+
+void atcClient::SetEnableOutputEffects(bool /*enableEffects*/) { }
+
+bool atcClient::GetEnableInputFilters() const { return true; }
+
+void atcClient::StartAudio() { }
+
+void atcClient::StopAudio() { }
+
+bool atcClient::IsAudioRunning() { return true; }
+
+void atcClient::SetTx(unsigned int freq, bool active)
+{
+    setFrequency(freq, &FakeFrequencyState::tx, active);
+}
+
+void atcClient::SetRx(unsigned int freq, bool active)
+{
+    setFrequency(freq, &FakeFrequencyState::rx, active);
+}
+
+void atcClient::SetXc(unsigned int freq, bool active)
+{
+    setFrequency(freq, &FakeFrequencyState::xc, active);
+}
+
+void atcClient::SetOnHeadset(unsigned int freq, bool active)
+{
+    setFrequency(freq, &FakeFrequencyState::onHeadset, active);
+}
+
+bool atcClient::GetTxActive(unsigned int /*freq*/) { return fakePtt; }
+
+bool atcClient::GetRxActive(unsigned int /*freq*/) { return false; }
+
+bool atcClient::GetOnHeadset(unsigned int freq)
+{
+    return withFrequency(freq, &FakeFrequencyState::onHeadset);
+}
+
+bool atcClient::GetTxState(unsigned int freq)
+{
+    return withFrequency(freq, &FakeFrequencyState::tx);
+}
+
+bool atcClient::GetRxState(unsigned int freq)
+{
+    return withFrequency(freq, &FakeFrequencyState::rx);
+}
+
+bool atcClient::GetXcState(unsigned int freq)
+{
+    return withFrequency(freq, &FakeFrequencyState::xc);
+}
+
+void atcClient::UseTransceiversFromStation(std::string /*station*/, int /*freq*/)
+{
+}
+
+void atcClient::FetchTransceiverInfo(std::string /*station*/) { }
+
+void atcClient::FetchStationVccs(std::string /*station*/) { }
+
+void atcClient::GetStation(std::string /*station*/) { }
+
+int atcClient::GetTransceiverCountForStation(std::string /*station*/)
+{
+    return 1;
+}
+
+void atcClient::SetPtt(bool pttState) { fakePtt = pttState; }
+
+void atcClient::SetAtisRecording(bool /*state*/) { }
+
+bool atcClient::IsAtisRecording() { return false; }
+
+void atcClient::SetAtisListening(bool /*state*/) { }
+
+bool atcClient::IsAtisListening() { return false; }
+
+void atcClient::StartAtisPlayback(std::string /*callsign*/, unsigned int /*freq*/)
+{
+}
+
+void atcClient::StopAtisPlayback() { }
+
+bool atcClient::IsAtisPlayingBack() { return false; }
+
+std::string atcClient::LastTransmitOnFreq(unsigned int /*freq*/) { return ""; }
+
+void atcClient::SetRadioGainAll(float /*gain*/) { }
+
+void atcClient::SetRadioGain(unsigned int /*freq*/, float /*gain*/) { }
+
+void atcClient::SetPlaybackChannelAll(PlaybackChannel /*channel*/) { }
+
+void atcClient::SetPlaybackChannel(
+    unsigned int /*freq*/, PlaybackChannel /*channel*/)
+{
+}
+
+void atcClient::AddFrequency(unsigned int freq, std::string stationName)
+{
+    const std::lock_guard<std::mutex> lock(fakeStateMutex);
+    fakeFrequencies[freq].station = std::move(stationName);
+}
+
+void atcClient::RemoveFrequency(unsigned int freq)
+{
+    const std::lock_guard<std::mutex> lock(fakeStateMutex);
+    fakeFrequencies.erase(freq);
+}
+
+bool atcClient::IsFrequencyActive(unsigned int freq)
+{
+    const std::lock_guard<std::mutex> lock(fakeStateMutex);
+    return fakeFrequencies.find(freq) != fakeFrequencies.end();
+}
+
+void atcClient::SetHardware(afv_native::HardwareType /*hardware*/) { }
+
+void atcClient::RaiseClientEvent(
+    std::function<void(afv_native::ClientEventType, void*, void*)> callback)
+{
+    fakeCallback = std::move(callback);
+}
+} // namespace afv_native::api
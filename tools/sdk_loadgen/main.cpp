@@ -0,0 +1,428 @@
+// SDK load generator
+//
+// Starts the VectorAudio SDK server in-process on top of a fake radio client,
+// then hammers it with websocket subscribers and polling HTTP clients while a
+// generator thread emits RX begin/end events. The report is written as JSON so
+// it can be diffed between builds.
+//
+// Usage: sdk_loadgen [--ws N] [--http M] [--duration SECONDS] [--rate EVENTS/S]
+//                    [--stations K] [--port PORT] [--output FILE]
+
+#include "sdk/sdk.h"
+#include "shared.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <httplib.h>
+#include <iostream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <restinio/asio_include.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+namespace asio = restinio::asio_ns;
+
+struct Options {
+    int wsClients = 50;
+    int httpClients = 10;
+    int durationSeconds = 10;
+    int eventRate = 200; // RX begin/end pairs per second
+    int stations = 20;
+    int port = 49180;
+    std::string output;
+};
+
+// Messages are identified by the callsign we put in them, "LG<id>"
+constexpr const char* kCallsignPrefix = "LG";
+
+struct LatencySummary {
+    size_t count = 0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+LatencySummary summarise(std::vector<double>& samples)
+{
+    LatencySummary out;
+    out.count = samples.size();
+    if (samples.empty()) {
+        return out;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        auto idx = static_cast<size_t>(q * static_cast<double>(samples.size() - 1));
+        return samples[idx];
+    };
+    out.p50 = at(0.50);
+    out.p99 = at(0.99);
+    out.max = samples.back();
+    return out;
+}
+
+nlohmann::json toJson(const LatencySummary& s)
+{
+    return { { "samples", s.count }, { "p50", s.p50 }, { "p99", s.p99 },
+        { "max", s.max } };
+}
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch())
+        .count();
+}
+
+// Send times of every generated message, indexed by message id
+class SendLog {
+public:
+    explicit SendLog(size_t capacity)
+        : pTimes(std::make_unique<std::atomic<int64_t>[]>(capacity))
+        , pCapacity(capacity)
+    {
+    }
+
+    bool record(size_t id)
+    {
+        if (id >= pCapacity) {
+            return false;
+        }
+        pTimes[id].store(nowNs(), std::memory_order_release);
+        return true;
+    }
+
+    int64_t sentAt(size_t id) const
+    {
+        if (id >= pCapacity) {
+            return 0;
+        }
+        return pTimes[id].load(std::memory_order_acquire);
+    }
+
+private:
+    std::unique_ptr<std::atomic<int64_t>[]> pTimes;
+    size_t pCapacity;
+};
+
+struct WsResult {
+    bool connected = false;
+    uint64_t received = 0;
+    std::vector<double> latenciesUs;
+};
+
+// Minimal RFC 6455 client: upgrade, then read unmasked server frames until
+// the stop flag is raised or the socket closes.
+void runWebsocketClient(int port, const SendLog& sendLog,
+    const std::atomic<bool>& stop, WsResult& result)
+{
+    try {
+        asio::io_context io;
+        asio::ip::tcp::socket socket(io);
+        socket.connect(asio::ip::tcp::endpoint(
+            asio::ip::make_address("127.0.0.1"), static_cast<uint16_t>(port)));
+
+        std::string handshake = "GET /ws HTTP/1.1\r\n"
+                                "Host: 127.0.0.1:"
+            + std::to_string(port)
+            + "\r\n"
+              "Upgrade: websocket\r\n"
+              "Connection: Upgrade\r\n"
+              "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+              "Sec-WebSocket-Version: 13\r\n\r\n";
+        asio::write(socket, asio::buffer(handshake));
+
+        asio::streambuf buf;
+        asio::read_until(socket, buf, "\r\n\r\n");
+        std::string statusLine;
+        std::istream headerStream(&buf);
+        std::getline(headerStream, statusLine);
+        if (statusLine.find("101") == std::string::npos) {
+            return;
+        }
+        // Drop the rest of the handshake headers but keep any frame bytes
+        // that were read along with them
+        std::string line;
+        while (std::getline(headerStream, line) && line != "\r") { }
+        result.connected = true;
+
+        // Reads block until the server shuts the connection down at the end
+        // of the run
+        std::vector<uint8_t> pending(asio::buffers_begin(buf.data()),
+            asio::buffers_end(buf.data()));
+        buf.consume(buf.size());
+
+        auto readExact = [&](uint8_t* out, size_t n) {
+            size_t fromPending = std::min(n, pending.size());
+            std::copy_n(pending.begin(), fromPending, out);
+            pending.erase(pending.begin(),
+                pending.begin() + static_cast<std::ptrdiff_t>(fromPending));
+            if (fromPending < n) {
+                asio::read(socket, asio::buffer(out + fromPending, n - fromPending));
+            }
+        };
+
+        std::string payload;
+        while (!stop.load(std::memory_order_relaxed)) {
+            uint8_t header[2];
+            readExact(header, 2);
+            uint8_t opcode = header[0] & 0x0F;
+            uint64_t len = header[1] & 0x7F;
+            if (len == 126) {
+                uint8_t ext[2];
+                readExact(ext, 2);
+                len = (static_cast<uint64_t>(ext[0]) << 8) | ext[1];
+            } else if (len == 127) {
+                uint8_t ext[8];
+                readExact(ext, 8);
+                len = 0;
+                for (auto b : ext) {
+                    len = (len << 8) | b;
+                }
+            }
+
+            payload.resize(len);
+            if (len > 0) {
+                readExact(reinterpret_cast<uint8_t*>(payload.data()), len);
+            }
+
+            if (opcode == 0x8) {
+                break; // Close frame
+            }
+            if (opcode != 0x1) {
+                continue;
+            }
+
+            auto receivedAt = nowNs();
+            auto pos = payload.find(std::string("\"") + kCallsignPrefix);
+            if (pos == std::string::npos) {
+                continue; // kFrequenciesUpdate and friends
+            }
+            auto id = std::strtoull(payload.c_str() + pos + 3, nullptr, 10);
+            auto sentAt = sendLog.sentAt(id);
+            result.received++;
+            if (sentAt != 0) {
+                result.latenciesUs.push_back(
+                    static_cast<double>(receivedAt - sentAt) / 1000.0);
+            }
+        }
+    } catch (const std::exception&) {
+        // Socket closed by the server on shutdown, or connection refused
+    }
+}
+
+struct HttpResult {
+    uint64_t requests = 0;
+    uint64_t errors = 0;
+    std::vector<double> latenciesUs;
+};
+
+void runHttpClient(int port, const std::string& endpoint,
+    const std::atomic<bool>& stop, HttpResult& result)
+{
+    httplib::Client cli("127.0.0.1", port);
+    cli.set_keep_alive(true);
+    cli.set_connection_timeout(std::chrono::seconds(2));
+    cli.set_read_timeout(std::chrono::seconds(2));
+
+    while (!stop.load(std::memory_order_relaxed)) {
+        auto t1 = Clock::now();
+        auto res = cli.Get(endpoint);
+        auto t2 = Clock::now();
+        result.requests++;
+        if (!res || res->status != 200) {
+            result.errors++;
+            continue;
+        }
+        result.latenciesUs.push_back(
+            std::chrono::duration<double, std::micro>(t2 - t1).count());
+    }
+}
+
+bool parseOptions(int argc, char** argv, Options& opts)
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--ws") {
+            opts.wsClients = std::stoi(value);
+        } else if (arg == "--http") {
+            opts.httpClients = std::stoi(value);
+        } else if (arg == "--duration") {
+            opts.durationSeconds = std::stoi(value);
+        } else if (arg == "--rate") {
+            opts.eventRate = std::stoi(value);
+        } else if (arg == "--stations") {
+            opts.stations = std::stoi(value);
+        } else if (arg == "--port") {
+            opts.port = std::stoi(value);
+        } else if (arg == "--output") {
+            opts.output = value;
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    Options opts;
+    try {
+        if (!parseOptions(argc, argv, opts)) {
+            return 1;
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "Invalid option value: " << ex.what() << "\n";
+        return 1;
+    }
+
+    spdlog::set_level(spdlog::level::warn);
+
+    vector_audio::shared::apiServerPort = opts.port;
+    auto client = std::make_shared<afv_native::api::atcClient>("sdk_loadgen");
+
+    {
+        std::lock_guard<std::mutex> lock(vector_audio::shared::fetchedStationMutex);
+        for (int i = 0; i < opts.stations; i++) {
+            int freq = 118000000 + i * 25000;
+            auto callsign = "LOAD_" + std::to_string(i) + "_CTR";
+            client->AddFrequency(freq, callsign);
+            vector_audio::shared::fetchedStations.push_back(
+                ns::Station::build(callsign, freq));
+        }
+    }
+
+    auto sdk = std::make_unique<vector_audio::SDK>(client);
+    if (!sdk->start()) {
+        std::cerr << "Could not start the SDK server on port " << opts.port
+                  << "\n";
+        return 1;
+    }
+    // Give restinio a moment to bind before clients pile in
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto maxMessages = static_cast<size_t>(opts.eventRate) * 2
+        * static_cast<size_t>(opts.durationSeconds + 1);
+    SendLog sendLog(maxMessages);
+
+    std::atomic<bool> stopClients = false;
+    std::vector<WsResult> wsResults(static_cast<size_t>(opts.wsClients));
+    std::vector<std::thread> threads;
+    for (auto& r : wsResults) {
+        threads.emplace_back([&, port = opts.port]() {
+            runWebsocketClient(port, sendLog, stopClients, r);
+        });
+    }
+
+    const std::vector<std::string> endpoints
+        = { "/rx", "/tx", "/transmitting" };
+    std::vector<HttpResult> httpResults(
+        static_cast<size_t>(opts.httpClients) * endpoints.size());
+    for (size_t i = 0; i < httpResults.size(); i++) {
+        threads.emplace_back([&, i, port = opts.port]() {
+            runHttpClient(port, endpoints[i % endpoints.size()], stopClients,
+                httpResults[i]);
+        });
+    }
+
+    // Let the websocket clients finish their upgrade before counting
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    // Fake radio: alternate RX begin/end on a rotating set of frequencies
+    size_t sent = 0;
+    auto interval = std::chrono::nanoseconds(1000000000LL / std::max(1, opts.eventRate));
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::seconds(opts.durationSeconds);
+    auto next = start;
+    while (Clock::now() < deadline && sent + 2 <= maxMessages) {
+        int freq = 118000000 + static_cast<int>(sent / 2 % static_cast<size_t>(std::max(1, opts.stations))) * 25000;
+
+        for (auto event : { vector_audio::sdk::types::Event::kRxBegin,
+                 vector_audio::sdk::types::Event::kRxEnd }) {
+            auto callsign = kCallsignPrefix + std::to_string(sent);
+            sendLog.record(sent);
+            sdk->handleAFVEventForWebsocket(event, callsign, freq);
+            if (event == vector_audio::sdk::types::Event::kRxBegin) {
+                vector_audio::SDK::loopCleanup({ std::pmr::string(callsign) });
+            }
+            sent++;
+        }
+
+        next += interval;
+        std::this_thread::sleep_until(next);
+    }
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // Grace period for in-flight messages
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    stopClients = true;
+    sdk.reset(); // Closes websocket connections, unblocking the readers
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Aggregate
+    uint64_t wsConnected = 0;
+    uint64_t wsReceived = 0;
+    std::vector<double> wsLatencies;
+    for (auto& r : wsResults) {
+        wsConnected += r.connected ? 1 : 0;
+        wsReceived += r.received;
+        wsLatencies.insert(
+            wsLatencies.end(), r.latenciesUs.begin(), r.latenciesUs.end());
+    }
+    uint64_t wsExpected = wsConnected * sent;
+
+    nlohmann::json report;
+    report["config"] = { { "ws_clients", opts.wsClients },
+        { "http_clients_per_endpoint", opts.httpClients },
+        { "duration_s", opts.durationSeconds },
+        { "event_rate", opts.eventRate }, { "stations", opts.stations } };
+    report["websocket"] = { { "connected", wsConnected },
+        { "messages_sent", sent }, { "messages_expected", wsExpected },
+        { "messages_received", wsReceived },
+        { "dropped", wsExpected > wsReceived ? wsExpected - wsReceived : 0 },
+        { "throughput_msg_s", static_cast<double>(wsReceived) / elapsed },
+        { "latency_us", toJson(summarise(wsLatencies)) } };
+
+    for (size_t e = 0; e < endpoints.size(); e++) {
+        uint64_t requests = 0;
+        uint64_t errors = 0;
+        std::vector<double> latencies;
+        for (size_t i = e; i < httpResults.size(); i += endpoints.size()) {
+            requests += httpResults[i].requests;
+            errors += httpResults[i].errors;
+            latencies.insert(latencies.end(),
+                httpResults[i].latenciesUs.begin(),
+                httpResults[i].latenciesUs.end());
+        }
+        report["http"][endpoints[e]] = { { "requests", requests },
+            { "errors", errors },
+            { "throughput_req_s", static_cast<double>(requests) / elapsed },
+            { "latency_us", toJson(summarise(latencies)) } };
+    }
+
+    if (opts.output.empty()) {
+        std::cout << report.dump(2) << "\n";
+    } else {
+        std::ofstream ofs(opts.output);
+        ofs << report.dump(2) << "\n";
+    }
+
+    return 0;
+}
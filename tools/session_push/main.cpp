@@ -0,0 +1,56 @@
+// Session push stand-in
+//
+// Plays the part of a radar client plugin: tells a running VectorAudio that
+// the user logged on or off, through POST /session on the SDK.
+//
+// Usage: session_push connect CALLSIGN FREQUENCY_HZ [FACILITY [LAT LON]]
+//        session_push disconnect
+//        [--port PORT] may be given first, defaults to 49080
+
+#include <cstdlib>
+#include <httplib.h>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int port = 49080;
+    if (args.size() >= 2 && args[0] == "--port") {
+        port = std::atoi(args[1].c_str());
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    nlohmann::json body;
+    if (args.size() >= 3 && args[0] == "connect") {
+        body["connected"] = true;
+        body["callsign"] = args[1];
+        body["frequency"] = std::atoi(args[2].c_str());
+        if (args.size() >= 4) {
+            body["facility"] = std::atoi(args[3].c_str());
+        }
+        if (args.size() >= 6) {
+            body["latitude"] = std::atof(args[4].c_str());
+            body["longitude"] = std::atof(args[5].c_str());
+        }
+    } else if (!args.empty() && args[0] == "disconnect") {
+        body["connected"] = false;
+    } else {
+        std::cerr << "usage: session_push [--port PORT] connect CALLSIGN "
+                     "FREQUENCY_HZ [FACILITY [LAT LON]]\n"
+                     "       session_push [--port PORT] disconnect\n";
+        return 2;
+    }
+
+    httplib::Client cli("127.0.0.1", port);
+    auto res = cli.Post("/session", body.dump(), "application/json");
+    if (!res) {
+        std::cerr << "Could not reach VectorAudio on port " << port << "\n";
+        return 1;
+    }
+
+    std::cout << res->status << " " << res->body << "\n";
+    return res->status == 204 ? 0 : 1;
+}
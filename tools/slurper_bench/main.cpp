@@ -0,0 +1,132 @@
+// Slurper parser benchmark
+//
+// Compares the string_view slurper tokenizer against the previous
+// implementation, which split every line into a std::vector<std::string>,
+// on a synthetic payload shaped like a real slurper answer.
+//
+// Usage: slurper_bench [--lines N] [--iterations N]
+
+#include "slurper_parser.h"
+
+#include <absl/strings/match.h>
+#include <absl/strings/str_split.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+namespace slurper = vector_audio::vatsim::slurper;
+
+struct Parsed {
+    std::string callsign;
+    int frequencyHz = 0;
+    bool isAtc = false;
+    double latitude = 0.0;
+    double longitude = 0.0;
+};
+
+std::string buildPayload(int lines)
+{
+    std::string payload;
+    for (int i = 0; i < lines - 1; i++) {
+        payload += "1234567,EDDF_" + std::to_string(i)
+            + "_ATIS,atc,118.025,4,50.033333,8.570556\n";
+    }
+    payload += "1234567,EDDF_N_APP,atc,120.805,5,50.033333,8.570556\n";
+    return payload;
+}
+
+// The parser as it was before the string_view tokenizer
+bool parseLegacy(const std::string& data, Parsed& out)
+{
+    auto lines = absl::StrSplit(data, '\n');
+    for (const auto& line : lines) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::vector<std::string> res = absl::StrSplit(line, ',');
+        if (absl::EndsWith(res[1], "_ATIS")) {
+            continue;
+        }
+
+        auto freq = res[3];
+        freq.erase(std::remove(freq.begin(), freq.end(), '.'), freq.end());
+        out.callsign = res[1];
+        out.frequencyHz = std::atoi(freq.c_str()) * 1000;
+        out.isAtc = std::stoi(res[2], nullptr, 16) == 10;
+        out.latitude = std::atof(res[5].c_str());
+        out.longitude = std::atof(res[6].c_str());
+        return true;
+    }
+    return false;
+}
+
+bool parseCurrent(const std::string& data, Parsed& out)
+{
+    bool found = false;
+    slurper::forEachConnection(data, [&](const slurper::Connection& c) {
+        if (absl::EndsWith(c.callsign, "_ATIS")) {
+            return true;
+        }
+
+        out.callsign = std::string(c.callsign);
+        slurper::parseFrequencyHz(c.frequency, out.frequencyHz);
+        out.isAtc = slurper::parseTypeCode(c.type).value_or(0) == 10;
+        slurper::parseCoordinate(c.latitude, out.latitude);
+        slurper::parseCoordinate(c.longitude, out.longitude);
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+template <typename Fn>
+double benchmark(const char* name, const std::string& payload, int iterations,
+    Fn&& parse)
+{
+    Parsed parsed;
+    size_t matches = 0;
+
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        matches += parse(payload, parsed) ? 1 : 0;
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(
+        Clock::now() - start)
+                       .count();
+
+    auto perParse = elapsed / iterations;
+    std::cout << name << ": " << perParse << " us/parse (" << parsed.callsign
+              << " " << parsed.frequencyHz << " atc=" << parsed.isAtc
+              << ", matched " << matches << "/" << iterations << ")\n";
+    return perParse;
+}
+}
+
+int main(int argc, char** argv)
+{
+    int lines = 4;
+    int iterations = 200000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--lines") {
+            lines = std::max(1, std::atoi(argv[i + 1]));
+        } else if (arg == "--iterations") {
+            iterations = std::max(1, std::atoi(argv[i + 1]));
+        }
+    }
+
+    auto payload = buildPayload(lines);
+    std::cout << "Payload: " << lines << " lines, " << payload.size()
+              << " bytes, " << iterations << " iterations\n";
+
+    auto legacy = benchmark("legacy ", payload, iterations, parseLegacy);
+    auto current = benchmark("current", payload, iterations, parseCurrent);
+    std::cout << "speedup: " << legacy / current << "x\n";
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Shared memory radio state reader
+ *
+ * Reads the state VectorAudio publishes with nothing but
+ * include/sdk/vector_audio_state.h, as an overlay would. Written in C to
+ * keep that header honest.
+ *
+ * Usage: state_reader            prints the current state
+ *        state_reader watch      prints it again whenever it changes
+ *        state_reader bench N    times N reads
+ *        [--name NAME] may be given first, defaults to /vector_audio_state
+ */
+
+#include "sdk/vector_audio_state.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+static void print_state(const va_state* state)
+{
+    uint8_t i;
+
+    printf("sequence %u, writer %u, updated %llu\n", state->sequence,
+        state->writer_pid, (unsigned long long)state->updated_at_ms);
+    printf("%s, ptt %s, %s facility %u on %u Hz\n",
+        state->connected ? "connected" : "disconnected",
+        state->ptt ? "open" : "closed", state->callsign, state->facility,
+        state->session_frequency_hz);
+    for (i = 0; i < state->station_count && i < VA_STATE_MAX_STATIONS; i++) {
+        const va_state_station* station = &state->stations[i];
+        printf("  %-15s %10u %s%s%s%s%s%s %s\n", station->callsign,
+            station->frequency_hz,
+            station->flags & VA_STATION_RX ? "RX " : "   ",
+            station->flags & VA_STATION_TX ? "TX " : "   ",
+            station->flags & VA_STATION_XC ? "XC " : "   ",
+            station->flags & VA_STATION_HEADSET ? "HS " : "   ",
+            station->flags & VA_STATION_RX_ACTIVE ? "<" : " ",
+            station->flags & VA_STATION_TX_ACTIVE ? ">" : " ",
+            station->last_received);
+    }
+    for (i = 0; i < state->receiving_count && i < VA_STATE_MAX_RECEIVING;
+         i++) {
+        printf("  receiving %s\n", state->receiving[i]);
+    }
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(int argc, char** argv)
+{
+    const char* name = VA_STATE_SHM_NAME;
+    const va_state* shared;
+    va_state state;
+    int fd;
+
+    if (argc >= 3 && strcmp(argv[1], "--name") == 0) {
+        name = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        perror("shm_open, is VectorAudio running?");
+        return 1;
+    }
+    shared = mmap(NULL, sizeof(va_state), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shared == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    if (argc >= 3 && strcmp(argv[1], "bench") == 0) {
+        long count = atol(argv[2]);
+        long busy = 0;
+        long i;
+        double start = now_ns();
+        for (i = 0; i < count; i++) {
+            int result = va_state_read(shared, &state);
+            if (result == -1) {
+                fprintf(stderr, "not a compatible VectorAudio state\n");
+                return 1;
+            }
+            busy += result == -2;
+        }
+        printf("%ld reads, %.1f ns each, %ld gave up on a busy writer\n",
+            count, (now_ns() - start) / (double)count, busy);
+        return 0;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "watch") == 0) {
+        uint32_t last = 0;
+        for (;;) {
+            if (va_state_read(shared, &state) == 0
+                && state.sequence != last) {
+                last = state.sequence;
+                print_state(&state);
+            }
+            usleep(16000);
+        }
+    }
+
+    if (va_state_read(shared, &state) != 0) {
+        fprintf(stderr, "could not read a consistent state\n");
+        return 1;
+    }
+    print_state(&state);
+    return 0;
+}